@@ -14,6 +14,7 @@
 #include "ActorUtil.h"
 #include "Preference.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <typeinfo>
@@ -45,6 +46,7 @@ std::vector<float> Actor::g_vfCurrentBGMBeatPlayerNoOffset(NUM_PlayerNumber, 0);
 Actor *Actor::Copy() const { return new Actor(*this); }
 
 static float g_fCabinetLights[NUM_CabinetLight];
+static int g_iNumActorsCulled = 0;
 
 static const char *HorizAlignNames[] = {
 	"Left",
@@ -86,6 +88,16 @@ void Actor::SetBGMLight( int iLightNumber, float fCabinetLights )
 	g_fCabinetLights[iLightNumber] = fCabinetLights;
 }
 
+int Actor::GetNumCulled()
+{
+	return g_iNumActorsCulled;
+}
+
+void Actor::ResetNumCulled()
+{
+	g_iNumActorsCulled = 0;
+}
+
 void Actor::InitState()
 {
 	this->StopTweening();
@@ -164,6 +176,7 @@ Actor::Actor()
 	LUA->Release( L );
 
 	m_size = RageVector2( 1, 1 );
+	m_bLocalTransformValid = false;
 	InitState();
 	m_pParent = nullptr;
 	m_FakeParent= nullptr;
@@ -174,6 +187,9 @@ Actor::Actor()
 Actor::~Actor()
 {
 	StopTweening();
+	for( unsigned i = 0; i < m_SpareTweens.size(); ++i )
+		delete m_SpareTweens[i];
+	m_SpareTweens.clear();
 	UnsubscribeAll();
 	for(std::size_t i= 0; i < m_WrapperStates.size(); ++i)
 	{
@@ -188,6 +204,7 @@ Actor::Actor( const Actor &cpy ):
 	/* Don't copy an Actor in the middle of rendering. */
 	ASSERT( cpy.m_pTempState == nullptr );
 	m_pTempState = nullptr;
+	m_bLocalTransformValid = false;
 
 #define CPY(x) x = cpy.x
 	CPY( m_sName );
@@ -461,10 +478,17 @@ void Actor::Draw()
 		}
 		this->PreDraw();
 		ASSERT( m_pTempState != nullptr );
-		if(PartiallyOpaque())
+		if(!PartiallyOpaque() || IsZoomedToNothing())
+		{
+			++g_iNumActorsCulled;
+		}
+		else
 		{
 			this->BeginDraw();
-			this->DrawPrimitives();
+			if(IsDrawnOffScreen())
+				++g_iNumActorsCulled;
+			else
+				this->DrawPrimitives();
 			this->EndDraw();
 		}
 		this->PostDraw();
@@ -490,6 +514,33 @@ void Actor::Draw()
 	m_pTempState = nullptr;
 }
 
+bool Actor::IsZoomedToNothing() const
+{
+	// With two axes zoomed to 0, everything is flattened onto a line or a
+	// point, which covers no pixels.
+	int iZeroAxes = 0;
+	if( m_pTempState->scale.x * m_baseScale.x == 0 )
+		++iZeroAxes;
+	if( m_pTempState->scale.y * m_baseScale.y == 0 )
+		++iZeroAxes;
+	if( m_pTempState->scale.z * m_baseScale.z == 0 )
+		++iZeroAxes;
+	if( iZeroAxes < 2 )
+		return false;
+
+	// Checked last, since for a frame it walks the whole subtree.
+	return !DrawsOffScreen();
+}
+
+bool Actor::IsDrawnOffScreen() const
+{
+	RectF rect;
+	if( !GetLocalDrawBounds(rect) )
+		return false;
+
+	return DISPLAY->IsRectOffScreen( rect );
+}
+
 void Actor::PostDraw() // reset internal diffuse and glow
 {
 	m_internalDiffuse = RageColor(1, 1, 1, 1);
@@ -670,61 +721,87 @@ void Actor::PreDraw() // calculate actor properties
 	}
 }
 
-void Actor::BeginDraw()
+void Actor::UpdateLocalTransform()
 {
-	DISPLAY->PushMatrix(); // Save the current transformation matrix
+	float fInputs[13];
+	fInputs[0] = m_pTempState->pos.x;
+	fInputs[1] = m_pTempState->pos.y;
+	fInputs[2] = m_pTempState->pos.z;
+	fInputs[3] = m_pTempState->rotation.x + m_baseRotation.x;
+	fInputs[4] = m_pTempState->rotation.y + m_baseRotation.y;
+	fInputs[5] = m_pTempState->rotation.z + m_baseRotation.z;
+	fInputs[6] = m_pTempState->scale.x * m_baseScale.x;
+	fInputs[7] = m_pTempState->scale.y * m_baseScale.y;
+	fInputs[8] = m_pTempState->scale.z * m_baseScale.z;
+	fInputs[9] = 0;
+	fInputs[10] = 0;
+	if (unlikely(m_fHorizAlign != 0.5f || m_fVertAlign != 0.5f))
+	{
+		fInputs[9] = SCALE(m_fHorizAlign, 0.0f, 1.0f, +m_size.x / 2.0f, -m_size.x / 2.0f);
+		fInputs[10] = SCALE(m_fVertAlign, 0.0f, 1.0f, +m_size.y / 2.0f, -m_size.y / 2.0f);
+	}
+	fInputs[11] = m_pTempState->fSkewX;
+	fInputs[12] = m_pTempState->fSkewY;
 
-	// Get the position of the actor
-	const float posX = m_pTempState->pos.x;
-	const float posY = m_pTempState->pos.y;
-	const float posZ = m_pTempState->pos.z;
+	if (m_bLocalTransformValid && std::equal(fInputs, fInputs + 13, m_fLocalTransformInputs))
+		return;
+
+	std::copy(fInputs, fInputs + 13, m_fLocalTransformInputs);
+	m_bLocalTransformValid = true;
+	m_bLocalTransformIdentity = true;
+	RageMatrixIdentity(&m_LocalTransform);
 
-	if (posX != 0 || posY != 0 || posZ != 0)
+	// Multiply in the same order the display's matrix stack would.
+	RageMatrix m;
+	if (fInputs[0] != 0 || fInputs[1] != 0 || fInputs[2] != 0)
 	{
-		RageMatrix m;
-		RageMatrixTranslate(&m, posX, posY, posZ);
-		DISPLAY->PreMultMatrix(m);
+		RageMatrixTranslate(&m, fInputs[0], fInputs[1], fInputs[2]);
+		RageMatrixMultiply(&m_LocalTransform, &m_LocalTransform, &m);
+		m_bLocalTransformIdentity = false;
 	}
-
-	// Get the rotation of the actor
+	if (fInputs[3] != 0 || fInputs[4] != 0 || fInputs[5] != 0)
 	{
-		const float rotationX = m_pTempState->rotation.x + m_baseRotation.x;
-		const float rotationY = m_pTempState->rotation.y + m_baseRotation.y;
-		const float rotationZ = m_pTempState->rotation.z + m_baseRotation.z;
-
-		if (rotationX != 0 || rotationY != 0 || rotationZ != 0)
-		{
-			RageMatrix m;
-			RageMatrixRotationXYZ(&m, rotationX, rotationY, rotationZ);
-			DISPLAY->PreMultMatrix(m);
-		}
+		RageMatrixRotationXYZ(&m, fInputs[3], fInputs[4], fInputs[5]);
+		RageMatrixMultiply(&m_LocalTransform, &m_LocalTransform, &m);
+		m_bLocalTransformIdentity = false;
 	}
-
-	// Get the scale of the actor
+	if (fInputs[6] != 1 || fInputs[7] != 1 || fInputs[8] != 1)
 	{
-		const float scaleX = m_pTempState->scale.x * m_baseScale.x;
-		const float scaleY = m_pTempState->scale.y * m_baseScale.y;
-		const float scaleZ = m_pTempState->scale.z * m_baseScale.z;
-
-		if (scaleX != 1 || scaleY != 1 || scaleZ != 1)
-		{
-			RageMatrix m;
-			RageMatrixScale(&m, scaleX, scaleY, scaleZ);
-			DISPLAY->PreMultMatrix(m);
-		}
+		RageMatrixScale(&m, fInputs[6], fInputs[7], fInputs[8]);
+		RageMatrixMultiply(&m_LocalTransform, &m_LocalTransform, &m);
+		m_bLocalTransformIdentity = false;
 	}
-
-	// Adjust the alignment of the actor
-	if (unlikely(m_fHorizAlign != 0.5f || m_fVertAlign != 0.5f))
+	if (fInputs[9] != 0 || fInputs[10] != 0)
+	{
+		RageMatrixTranslate(&m, fInputs[9], fInputs[10], 0);
+		RageMatrixMultiply(&m_LocalTransform, &m_LocalTransform, &m);
+		m_bLocalTransformIdentity = false;
+	}
+	if (fInputs[11] != 0)
+	{
+		RageMatrixSkewX(&m, fInputs[11]);
+		RageMatrixMultiply(&m_LocalTransform, &m_LocalTransform, &m);
+		m_bLocalTransformIdentity = false;
+	}
+	if (fInputs[12] != 0)
 	{
-		float fX = SCALE(m_fHorizAlign, 0.0f, 1.0f, +m_size.x / 2.0f, -m_size.x / 2.0f);
-		float fY = SCALE(m_fVertAlign, 0.0f, 1.0f, +m_size.y / 2.0f, -m_size.y / 2.0f);
-		RageMatrix m;
-		RageMatrixTranslate(&m, fX, fY, 0);
-		DISPLAY->PreMultMatrix(m);
+		RageMatrixSkewY(&m, fInputs[12]);
+		RageMatrixMultiply(&m_LocalTransform, &m_LocalTransform, &m);
+		m_bLocalTransformIdentity = false;
 	}
+}
+
+void Actor::BeginDraw()
+{
+	DISPLAY->PushMatrix(); // Save the current transformation matrix
+
+	// Position, rotation, scale, alignment and skew, cached between frames.
+	UpdateLocalTransform();
+	if (!m_bLocalTransformIdentity)
+		DISPLAY->PreMultMatrix(m_LocalTransform);
 
-	// Get the quaternion of the actor
+	// The quaternion is applied about the world origin, so it's kept out of
+	// the cached matrix.
 	const float quatX = m_pTempState->quat.x;
 	const float quatY = m_pTempState->quat.y;
 	const float quatZ = m_pTempState->quat.z;
@@ -737,20 +814,6 @@ void Actor::BeginDraw()
 		DISPLAY->MultMatrix(mat);
 	}
 
-	// Get the skew of the actor along the X-axis
-	const float skewX = m_pTempState->fSkewX;
-	if (skewX != 0)
-	{
-		DISPLAY->SkewX(skewX); 
-	}
-
-	// Get the skew of the actor along the Y-axis
-	const float skewY = m_pTempState->fSkewY;
-	if (skewY != 0)
-	{
-		DISPLAY->SkewY(skewY);
-	}
-
 	// If the texture is not at the origin, translate the texture
 	if (m_texTranslate.x != 0 || m_texTranslate.y != 0)
 	{
@@ -828,9 +891,10 @@ void Actor::UpdateTweening(float fDeltaTime)
 		TI.m_fTimeLeftInTween -= fSecsToSubtract;
 		fDeltaTime -= fSecsToSubtract;
 
-		RString sCommand = TI.m_sCommandName;
+		RString sCommand;
 		if (bBeginning)            // we are just beginning this tween
 		{
+			sCommand = TI.m_sCommandName;
 			m_start = m_current;    // set the start position
 			SetCurrentTweenStart();
 		}
@@ -840,7 +904,7 @@ void Actor::UpdateTweening(float fDeltaTime)
 			m_current = TS;
 
 			// delete the head tween
-			delete firstTween;
+			RecycleTween(firstTween);
 			m_Tweens.erase(m_Tweens.begin());
 			EraseHeadTween();
 		}
@@ -1010,7 +1074,15 @@ void Actor::BeginTweening( float time, ITween *pTween )
 	}
 
 	// add a new TweenState to the tail, and initialize it
-	m_Tweens.push_back( new TweenStateAndInfo );
+	if( m_SpareTweens.empty() )
+	{
+		m_Tweens.push_back( new TweenStateAndInfo );
+	}
+	else
+	{
+		m_Tweens.push_back( m_SpareTweens.back() );
+		m_SpareTweens.pop_back();
+	}
 
 	// latest
 	TweenState &TS = m_Tweens.back()->state;
@@ -1044,10 +1116,27 @@ void Actor::BeginTweening( float time, TweenType tt )
 void Actor::StopTweening()
 {
 	for( unsigned i = 0; i < m_Tweens.size(); ++i )
-		delete m_Tweens[i];
+		RecycleTween( m_Tweens[i] );
 	m_Tweens.clear();
 }
 
+void Actor::RecycleTween( TweenStateAndInfo *pTween )
+{
+	// Most actors only ever have a few tweens queued at once.
+	const unsigned MAX_SPARE_TWEENS = 4;
+	if( m_SpareTweens.size() >= MAX_SPARE_TWEENS )
+	{
+		delete pTween;
+		return;
+	}
+
+	TweenInfo &TI = pTween->info;
+	delete TI.m_pTween;
+	TI.m_pTween = nullptr;
+	TI.m_sCommandName = RString();
+	m_SpareTweens.push_back( pTween );
+}
+
 void Actor::FinishTweening()
 {
 	if( !m_Tweens.empty() )
@@ -124,6 +124,11 @@ public:
 	static void SetPlayerBGMBeat( PlayerNumber pn, float fBeat, float fBeatNoOffset );
 	static void SetBGMLight( int iLightNumber, float fCabinetLights );
 
+	/* The number of actors Draw has skipped since ResetNumCulled because
+	 * they were transparent, zoomed to nothing, or entirely off screen. */
+	static int GetNumCulled();
+	static void ResetNumCulled();
+
 	/**
 	 * @brief The list of the different effects.
 	 *
@@ -255,6 +260,20 @@ public:
 	 * aborted actors.
 	 * @return false, as by default Actors shouldn't be aborted on drawing. */
 	virtual bool EarlyAbortDraw() const { return false; }
+	/**
+	 * @brief Get the area DrawPrimitives draws in, in local coordinates.
+	 *
+	 * Actors that know it can return true, so they're skipped when it's
+	 * entirely off screen.  It must contain everything drawn.
+	 * @return false, as by default Actors don't know what they draw. */
+	virtual bool GetLocalDrawBounds( RectF &rectOut ) const { return false; }
+	/**
+	 * @brief Does drawing this Actor have effects besides what's on screen?
+	 *
+	 * Actors that render somewhere else, like into a texture, return true
+	 * so that they aren't skipped when zoomed to nothing.  ActorFrames
+	 * return true if any of their children do. */
+	virtual bool DrawsOffScreen() const { return false; }
 	/** @brief Calculate values that may be needed  for drawing. */
 	virtual void PreDraw();
 	/** @brief Reset internal diffuse and glow. */
@@ -377,6 +396,8 @@ public:
 	virtual void  SetBaseAlpha( float fAlpha )	{ m_fBaseAlpha = fAlpha; }
 	void  SetInternalDiffuse( const RageColor &c )	{ m_internalDiffuse = c; }
 	void  SetInternalGlow( const RageColor &c )	{ m_internalGlow = c; }
+	/** @brief Will the next Draw render a glow pass, not counting effects? */
+	bool  HasGlow() const				{ return m_current.glow.a > 0 || m_internalGlow.a > 0; }
 
 	/**
 	 * @brief Retrieve the general zoom factor, using the x coordinate of the Actor.
@@ -587,9 +608,12 @@ public:
 	void SetTextureWrapping( bool b ) 			{ m_bTextureWrapping = b; }
 	void SetTextureFiltering( bool b ) 		{ m_bTextureFiltering = b; }
 	void SetClearZBuffer( bool b ) 			{ m_bClearZBuffer = b; }
+	bool GetClearZBuffer() const			{ return m_bClearZBuffer; }
 	void SetUseZBuffer( bool b ) 				{ SetZTestMode(b?ZTEST_WRITE_ON_PASS:ZTEST_OFF); SetZWrite(b); }
 	virtual void SetZTestMode( ZTestMode mode )	{ m_ZTestMode = mode; }
+	ZTestMode GetZTestMode() const			{ return m_ZTestMode; }
 	virtual void SetZWrite( bool b ) 			{ m_bZWrite = b; }
+	bool GetZWrite() const				{ return m_bZWrite; }
 	void SetZBias( float f )					{ m_fZBias = f; }
 	virtual void SetCullMode( CullMode mode ) { m_CullMode = mode; }
 
@@ -671,10 +695,25 @@ protected:
 		TweenInfo info;
 	};
 	std::vector<TweenStateAndInfo *>	m_Tweens;
+	/* Finished tweens, reused by BeginTweening so actors that tween
+	 * continuously don't allocate a new one each time. */
+	std::vector<TweenStateAndInfo *>	m_SpareTweens;
+	void RecycleTween( TweenStateAndInfo *pTween );
 
 	/** @brief Temporary variables that are filled just before drawing */
 	TweenState *m_pTempState;
 
+	/* The product of BeginDraw's translate, rotate, scale, align and skew,
+	 * reused while the values it was built from stay the same.  Most actors
+	 * don't move on most frames. */
+	float m_fLocalTransformInputs[13];
+	RageMatrix m_LocalTransform;
+	bool m_bLocalTransformIdentity;
+	bool m_bLocalTransformValid;
+	void UpdateLocalTransform();
+	bool IsZoomedToNothing() const;
+	bool IsDrawnOffScreen() const;
+
 	bool	m_bFirstUpdate;
 
 	// Stuff for alignment
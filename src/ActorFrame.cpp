@@ -10,6 +10,7 @@
 #include "RageDisplay.h"
 #include "ScreenDimensions.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -261,13 +262,13 @@ void ActorFrame::DrawPrimitives()
 	// draw all sub-ActorFrames while we're in the ActorFrame's local coordinate space
 	if( m_bDrawByZPosition )
 	{
-		std::vector<Actor*> subs = m_SubActors;
-		ActorUtil::SortByZPosition( subs );
-		for( unsigned i=0; i<subs.size(); i++ )
+		SortSubActorsByZPosition();
+		for( unsigned i=0; i<m_SubActorsByZ.size(); i++ )
 		{
-			subs[i]->SetInternalDiffuse( diffuse );
-			subs[i]->SetInternalGlow( glow );
-			subs[i]->Draw();
+			Actor *pActor = m_SubActorsByZ[i].first;
+			pActor->SetInternalDiffuse( diffuse );
+			pActor->SetInternalGlow( glow );
+			pActor->Draw();
 		}
 	}
 	else
@@ -281,6 +282,66 @@ void ActorFrame::DrawPrimitives()
 	}
 }
 
+// A frame zoomed to nothing still has to draw any child that renders into a
+// texture, such as an ActorFrameTexture hidden with zoom(0).  A DrawFunction
+// can draw anything, so assume it does.
+bool ActorFrame::DrawsOffScreen() const
+{
+	if( !m_DrawFunction.IsNil() )
+		return true;
+	for( unsigned i=0; i<m_SubActors.size(); i++ )
+	{
+		if( m_SubActors[i]->DrawsOffScreen() )
+			return true;
+	}
+	return false;
+}
+
+static bool CompareByZPosition( const std::pair<Actor*, unsigned> &a, const std::pair<Actor*, unsigned> &b )
+{
+	const float fZA = a.first->GetZ();
+	const float fZB = b.first->GetZ();
+	if( fZA != fZB )
+		return fZA < fZB;
+	return a.second < b.second;
+}
+
+void ActorFrame::SortSubActorsByZPosition()
+{
+	if( m_ZSortedFrom != m_SubActors )
+	{
+		m_ZSortedFrom = m_SubActors;
+		m_SubActorsByZ.resize( m_SubActors.size() );
+		for( unsigned i=0; i<m_SubActors.size(); i++ )
+			m_SubActorsByZ[i] = std::make_pair( m_SubActors[i], i );
+	}
+
+	/* Z positions rarely change from frame to frame, so last frame's order is
+	 * usually still sorted, or close to it.  Only do a full sort if a lot of
+	 * it is out of order. */
+	unsigned iOutOfOrder = 0;
+	for( unsigned i=1; i<m_SubActorsByZ.size(); i++ )
+	{
+		if( CompareByZPosition(m_SubActorsByZ[i], m_SubActorsByZ[i-1]) )
+			++iOutOfOrder;
+	}
+	if( iOutOfOrder == 0 )
+		return;
+	if( iOutOfOrder > 8 )
+	{
+		std::sort( m_SubActorsByZ.begin(), m_SubActorsByZ.end(), CompareByZPosition );
+		return;
+	}
+
+	for( unsigned i=1; i<m_SubActorsByZ.size(); i++ )
+	{
+		const std::pair<Actor*, unsigned> p = m_SubActorsByZ[i];
+		unsigned j = i;
+		for( ; j > 0 && CompareByZPosition(p, m_SubActorsByZ[j-1]); --j )
+			m_SubActorsByZ[j] = m_SubActorsByZ[j-1];
+		m_SubActorsByZ[j] = p;
+	}
+}
 
 void ActorFrame::EndDraw()
 {
@@ -3,6 +3,7 @@
 
 #include "Actor.h"
 
+#include <utility>
 #include <vector>
 
 /** @brief A container for other Actors. */
@@ -70,6 +71,7 @@ public:
 	virtual void BeginDraw();
 	virtual void DrawPrimitives();
 	virtual void EndDraw();
+	virtual bool DrawsOffScreen() const;
 
 	// propagated commands
 	virtual void SetZTestMode( ZTestMode mode );
@@ -105,6 +107,12 @@ protected:
 	bool m_bPropagateCommands;
 	bool m_bDeleteChildren;
 	bool m_bDrawByZPosition;
+	/* m_SubActors in the order they're drawn when m_bDrawByZPosition is set,
+	 * each with its index in m_SubActors so ties keep child order.  It's kept
+	 * between frames, and m_ZSortedFrom is the list it was built from. */
+	std::vector<std::pair<Actor*, unsigned>> m_SubActorsByZ;
+	std::vector<Actor*> m_ZSortedFrom;
+	void SortSubActorsByZPosition();
 	LuaReference m_UpdateFunction;
 	LuaReference m_DrawFunction;
 
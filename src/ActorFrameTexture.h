@@ -35,6 +35,7 @@ public:
 	void Create();
 
 	virtual void DrawPrimitives();
+	virtual bool DrawsOffScreen() const { return true; }
 
 	// Commands
 	virtual void PushSelf( lua_State *L );
@@ -240,16 +240,14 @@ namespace
 {
 	XNode *LoadXNodeFromLuaShowErrors( const RString &sFile )
 	{
-		RString sScript;
-		if( !GetFileContents(sFile, sScript) )
-			return nullptr;
-
 		Lua *L = LUA->Get();
 
 		RString sError;
-		if( !LuaHelpers::LoadScript(L, sScript, "@" + sFile, sError) )
+		if( !LuaHelpers::LoadScriptFile(L, sFile, sError) )
 		{
 			LUA->Release( L );
+			if( sError.empty() )
+				return nullptr;
 			sError = ssprintf( "Lua runtime error: %s", sError.c_str() );
 			LuaHelpers::ReportScriptError(sError);
 			return nullptr;
@@ -612,6 +610,12 @@ FileType ActorUtil::GetFileType( const RString &sPath )
 	return FileType_Invalid;
 }
 
+bool ActorUtil::CanCopyActorFrom( const RString &sPath )
+{
+	FileType ft = GetFileType( sPath );
+	return ft == FT_Bitmap || ft == FT_Sprite;
+}
+
 
 // lua start
 #include "LuaBinding.h"
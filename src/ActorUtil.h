@@ -129,6 +129,11 @@ namespace ActorUtil
 	void SortByZPosition( std::vector<Actor*> &vActors );
 
 	FileType GetFileType( const RString &sPath );
+	/* Whether every actor MakeActor builds from this file is the same, so
+	 * one can be loaded and Copy()'d for the rest.  True only for images and
+	 * sprite files; Lua and XML can make something different each time they
+	 * run, and copies of them share Lua closures. */
+	bool CanCopyActorFrom( const RString &sPath );
 };
 
 #define SET_XY( actor )			ActorUtil::SetXY( actor, m_sName )
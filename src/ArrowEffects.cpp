@@ -85,8 +85,6 @@ static ThemeMetric<float>	TINY_PERCENT_GATE( "ArrowEffects", "TinyPercentGate" )
 
 static const PlayerOptions* curr_options= nullptr;
 
-float ArrowGetPercentVisible(float fYPosWithoutReverse, int iCol, float fYOffset);
-
 static float GetNoteFieldHeight()
 {
 	return SCREEN_HEIGHT + std::abs(curr_options->m_fPerspectiveTilt)*200;
@@ -125,6 +123,9 @@ namespace
 		float m_fBeatFactor[3];
 		float m_fExpandSeconds;
 		float m_fTanExpandSeconds;
+		float m_fExpandMultiplier;
+		float m_fTanExpandMultiplier;
+		std::size_t m_iDisplayedBeatCursor;
 
 		// m_prev_style is for checking whether ArrowEffects::Init needs to be
 		// called.  Finding all the placed ArrowEffects is used and making sure
@@ -152,46 +153,175 @@ static float SelectTanType(float angle, bool is_cosec)
 	    return RageFastTan(angle);
 }
 
-static float CalculateTornadoOffsetFromMagnitude(int dimension, int col_id,
+static float CalculateBumpyAngle(float y_offset, float offset, float period)
+{
+	return (y_offset+(100.0f*offset))/((period*16.0f)+16.0f);
+}
+
+static float CalculateDigitalAngle(float y_offset, float offset, float period)
+{
+	return PI * (y_offset + (1.0f * offset ) ) / (ARROW_SIZE + (period * ARROW_SIZE) );
+}
+
+// The Add*Offsets functions below each apply one effect to a whole batch of
+// notes in a column.  Anything that doesn't depend on the y offset is worked
+// out before the loop, so the loop itself is a short run of arithmetic over
+// the arrays.
+static void AddTornadoOffsets(int dimension, int col_id,
 	float magnitude, float effect_offset, float period,
 	const Style::ColumnInfo* pCols, float field_zoom,
-	PerPlayerData& data, float y_offset, bool is_tan)
+	const PerPlayerData& data, bool is_tan,
+	const float* y_offsets, float* out, int count)
 {
 	float const real_pixel_offset= pCols[col_id].fXOffset * field_zoom;
+	float const min_pixel_offset= data.m_MinTornado[dimension][col_id] * field_zoom;
+	float const max_pixel_offset= data.m_MaxTornado[dimension][col_id] * field_zoom;
 	float const position_between= SCALE(real_pixel_offset,
-		data.m_MinTornado[dimension][col_id] * field_zoom,
-		data.m_MaxTornado[dimension][col_id] * field_zoom,
+		min_pixel_offset, max_pixel_offset,
 		tornado_position_scale_to_low[dimension],
 		tornado_position_scale_to_high[dimension]);
-	float rads= std::acos(position_between);
-	float frequency= tornado_offset_frequency[dimension];
-	rads+= (y_offset + effect_offset) * ((period * frequency) + frequency) / SCREEN_HEIGHT;
-	float processed_rads = is_tan ? SelectTanType(rads, curr_options->m_bCosecant) : RageFastCos(rads);
+	float const base_rads= std::acos(position_between);
+	float const frequency= tornado_offset_frequency[dimension];
+	float const rads_scale= (period * frequency) + frequency;
+	float const screen_height= SCREEN_HEIGHT;
+	float const scale_from_low= tornado_offset_scale_from_low[dimension];
+	float const scale_from_high= tornado_offset_scale_from_high[dimension];
+	bool const is_cosec= curr_options->m_bCosecant;
+	for(int i= 0; i < count; ++i)
+	{
+		float const rads= base_rads + (y_offsets[i] + effect_offset) * rads_scale / screen_height;
+		float const processed_rads= is_tan ? SelectTanType(rads, is_cosec) : RageFastCos(rads);
+		float const adjusted_pixel_offset= SCALE(processed_rads,
+			scale_from_low, scale_from_high,
+			min_pixel_offset, max_pixel_offset);
+		out[i]+= (adjusted_pixel_offset - real_pixel_offset) * magnitude;
+	}
+}
+
+static void AddDrunkOffsets(float magnitude, float speed, int col,
+	float offset, float col_frequency, float period, float offset_frequency,
+	float arrow_magnitude, float time, bool is_tan,
+	const float* y_offsets, float* out, int count)
+{
+	float const base_angle= time * (1+speed) + col*( (offset*col_frequency) + col_frequency);
+	float const angle_scale= (period*offset_frequency) + offset_frequency;
+	float const screen_height= SCREEN_HEIGHT;
+	bool const is_cosec= curr_options->m_bCosecant;
+	for(int i= 0; i < count; ++i)
+	{
+		float const angle= base_angle + y_offsets[i] * angle_scale / screen_height;
+		float const wave= is_tan ? SelectTanType(angle, is_cosec) : RageFastCos(angle);
+		out[i]+= magnitude * ( wave * ARROW_SIZE*arrow_magnitude );
+	}
+}
 
-	float const adjusted_pixel_offset= SCALE(processed_rads,
-		tornado_offset_scale_from_low[dimension],
-		tornado_offset_scale_from_high[dimension],
-		data.m_MinTornado[dimension][col_id] * field_zoom,
-		data.m_MaxTornado[dimension][col_id] * field_zoom);
-	return (adjusted_pixel_offset - real_pixel_offset) * magnitude;
+static void AddBumpyOffsets(float magnitude, float offset, float period,
+	bool is_tan, const float* y_offsets, float* out, int count)
+{
+	bool const is_cosec= curr_options->m_bCosecant;
+	for(int i= 0; i < count; ++i)
+	{
+		float const angle= CalculateBumpyAngle(y_offsets[i], offset, period);
+		float const wave= is_tan ? SelectTanType(angle, is_cosec) : RageFastSin(angle);
+		out[i]+= magnitude * 40*wave;
+	}
 }
 
-static float CalculateDrunkAngle(float speed, int col, float offset,
-	float col_frequency, float y_offset, float period, float offset_frequency)
+static void AddBeatOffsets(float magnitude, float beat_factor, float period,
+	float offset_height, float pi_height,
+	const float* y_offsets, float* out, int count)
 {
-	float time = ArrowEffects::GetTime();
-	return time * (1+speed) + col*( (offset*col_frequency) + col_frequency)
-		+ y_offset * ( (period*offset_frequency) + offset_frequency) / SCREEN_HEIGHT;
+	float const height= (period*offset_height)+offset_height;
+	float const phase= PI/pi_height;
+	for(int i= 0; i < count; ++i)
+	{
+		float const shift= beat_factor*RageFastSin( y_offsets[i] / height + phase );
+		out[i]+= magnitude * shift;
+	}
 }
 
-static float CalculateBumpyAngle(float y_offset, float offset, float period)
+static void AddZigZagOffsets(float magnitude, float offset, float period,
+	const float* y_offsets, float* out, int count)
 {
-	return (y_offset+(100.0f*offset))/((period*16.0f)+16.0f);
+	float const frequency= PI * (1/(period+1));
+	float const pixel_offset= 100.0f*offset;
+	float const amplitude= magnitude*ARROW_SIZE/2;
+	for(int i= 0; i < count; ++i)
+	{
+		float const result= RageTriangle( frequency * ((y_offsets[i]+pixel_offset)/ARROW_SIZE) );
+		out[i]+= amplitude * result;
+	}
 }
 
-static float CalculateDigitalAngle(float y_offset, float offset, float period)
+static void AddSawtoothOffsets(float magnitude, float period,
+	const float* y_offsets, float* out, int count)
 {
-	return PI * (y_offset + (1.0f * offset ) ) / (ARROW_SIZE + (period * ARROW_SIZE) );
+	float const frequency= 0.5f / (period+1);
+	float const amplitude= magnitude*ARROW_SIZE;
+	for(int i= 0; i < count; ++i)
+	{
+		float const position= (frequency * y_offsets[i]) / ARROW_SIZE;
+		out[i]+= amplitude * (position - std::floor(position));
+	}
+}
+
+// Parabola, and attenuate with column_scale set to the column's x offset.
+static void AddParabolaOffsets(float magnitude, float column_scale,
+	const float* y_offsets, float* out, int count)
+{
+	for(int i= 0; i < count; ++i)
+	{
+		float const y= y_offsets[i];
+		out[i]+= magnitude * (y/ARROW_SIZE) * (y/ARROW_SIZE) * column_scale;
+	}
+}
+
+static void AddDigitalOffsets(float magnitude, float steps, float offset,
+	float period, bool is_tan, const float* y_offsets, float* out, int count)
+{
+	float const amplitude= magnitude * ARROW_SIZE * 0.5f;
+	float const num_steps= steps+1;
+	bool const is_cosec= curr_options->m_bCosecant;
+	for(int i= 0; i < count; ++i)
+	{
+		float const angle= CalculateDigitalAngle(y_offsets[i], offset, period);
+		float const wave= is_tan ? SelectTanType(angle, is_cosec) : RageFastSin(angle);
+		out[i]+= amplitude * std::round(num_steps * wave) / num_steps;
+	}
+}
+
+static void AddSquareOffsets(float magnitude, float offset, float period,
+	const float* y_offsets, float* out, int count)
+{
+	float const pixel_offset= 1.0f*offset;
+	float const width= ARROW_SIZE+(period*ARROW_SIZE);
+	float const amplitude= magnitude * ARROW_SIZE * 0.5f;
+	for(int i= 0; i < count; ++i)
+	{
+		float const result= RageSquare( (PI * (y_offsets[i]+pixel_offset) / width) );
+		out[i]+= amplitude * result;
+	}
+}
+
+static void AddBounceOffsets(float magnitude, float offset, float period,
+	const float* y_offsets, float* out, int count)
+{
+	float const pixel_offset= 1.0f*offset;
+	float const height= 60 + (period*60);
+	float const amplitude= magnitude * ARROW_SIZE * 0.5f;
+	for(int i= 0; i < count; ++i)
+	{
+		float const bounce= std::abs( RageFastSin( (y_offsets[i] + pixel_offset) / height ) );
+		out[i]+= amplitude * bounce;
+	}
+}
+
+static void AddConstantOffset(float offset, float* out, int count)
+{
+	for(int i= 0; i < count; ++i)
+	{
+		out[i]+= offset;
+	}
 }
 
 static void UpdateBeat(int dimension, PerPlayerData &data, const SongPosition &position, float beat_offset, float beat_mult)
@@ -326,6 +456,7 @@ void ArrowEffects::Update()
 		? GAMESTATE->m_pPlayerState[pn]->m_Position : GAMESTATE->m_Position;
 		const float* effects= GAMESTATE->m_pPlayerState[pn]->m_PlayerOptions.GetCurrent().m_fEffects;
 		const float* accels= GAMESTATE->m_pPlayerState[pn]->m_PlayerOptions.GetCurrent().m_fAccels;
+		const bool bCosecant= GAMESTATE->m_pPlayerState[pn]->m_PlayerOptions.GetCurrent().m_bCosecant;
 
 		PerPlayerData &data = g_EffectData[pn];
 
@@ -343,6 +474,15 @@ void ArrowEffects::Update()
 			data.m_fTanExpandSeconds = std::fmod( data.m_fTanExpandSeconds, (PI*2)/(accels[PlayerOptions::ACCEL_TAN_EXPAND_PERIOD]+1) );
 		}
 
+		// The expand multipliers only change with time, so work them out once
+		// here instead of for every note.
+		data.m_fExpandMultiplier = SCALE( RageFastCos(data.m_fExpandSeconds*EXPAND_MULTIPLIER_FREQUENCY*(accels[PlayerOptions::ACCEL_EXPAND_PERIOD]+1)),
+						EXPAND_MULTIPLIER_SCALE_FROM_LOW, EXPAND_MULTIPLIER_SCALE_FROM_HIGH,
+						EXPAND_MULTIPLIER_SCALE_TO_LOW, EXPAND_MULTIPLIER_SCALE_TO_HIGH );
+		data.m_fTanExpandMultiplier = SCALE( SelectTanType(data.m_fTanExpandSeconds*EXPAND_MULTIPLIER_FREQUENCY*(accels[PlayerOptions::ACCEL_TAN_EXPAND_PERIOD]+1), bCosecant),
+						EXPAND_MULTIPLIER_SCALE_FROM_LOW, EXPAND_MULTIPLIER_SCALE_FROM_HIGH,
+						EXPAND_MULTIPLIER_SCALE_TO_LOW, EXPAND_MULTIPLIER_SCALE_TO_HIGH );
+
 		// Update Invert
 		for( int iColNum = 0; iColNum < MAX_COLS_PER_PLAYER; ++iColNum )
 		{
@@ -434,84 +574,136 @@ void ArrowEffects::SetCurrentOptions(const PlayerOptions* options)
 	curr_options= options;
 }
 
-static float GetDisplayedBeat( const PlayerState* pPlayerState, float beat )
+namespace
+{
+	// The parts of GetYOffset that are the same for every note in the column,
+	// so that a batch only has to look them up once.
+	struct YOffsetContext
+	{
+		const TimingData* timing;
+		const TimingData* displayed_timing;
+		// Starts at the song beat's entry and follows the notes.
+		std::size_t displayed_beat_cursor;
+		float song_beat;
+		float displayed_song_beat;
+		float displayed_speed_percent;
+		float song_seconds;
+		float time_spacing_bps;
+		float arrow_spacing;
+		float scroll_speed;
+		float expand_speed;
+		float tan_expand_speed;
+		float note_field_height;
+		bool in_step_editor;
+	};
+};
+
+static void PrepareYOffsetContext( const PlayerState* pPlayerState, YOffsetContext &ctx )
 {
-	// do a binary search here
-	const std::vector<CacheDisplayedBeat> &data = pPlayerState->m_CacheDisplayedBeat;
-	int max = data.size() - 1;
-	int l = 0, r = max;
-	while( l <= r )
+	const SongPosition &position = pPlayerState->GetDisplayedPosition();
+	const float* fAccels = curr_options->m_fAccels;
+
+	// TODO: Don't index by PlayerNumber.
+	PerPlayerData &data = g_EffectData[pPlayerState->m_PlayerNumber];
+
+	ctx.timing = nullptr;
+	ctx.displayed_timing = nullptr;
+	ctx.displayed_beat_cursor = 0;
+	ctx.song_beat = position.m_fSongBeatVisible;
+	ctx.displayed_song_beat = 0;
+	ctx.displayed_speed_percent = 1;
+	ctx.song_seconds = 0;
+	ctx.time_spacing_bps = 0;
+	ctx.in_step_editor = GAMESTATE->m_bInStepEditor;
+
+	const bool bBeatSpacing = curr_options->m_fTimeSpacing != 1.0f && !ctx.in_step_editor;
+	const bool bTimeSpacing = curr_options->m_fTimeSpacing != 0.0f;
+	if( bBeatSpacing || bTimeSpacing )
+		ctx.timing = GAMESTATE->m_pCurSteps[pPlayerState->m_PlayerNumber]->GetTimingData();
+	if( bBeatSpacing )
+	{
+		// The song beat only moves forward a little each frame, so its cursor
+		// is kept from frame to frame.
+		ctx.displayed_timing = &pPlayerState->GetDisplayedTiming();
+		ctx.displayed_song_beat = ctx.displayed_timing->GetDisplayedBeat( ctx.song_beat, data.m_iDisplayedBeatCursor );
+		ctx.displayed_beat_cursor = data.m_iDisplayedBeatCursor;
+		ctx.displayed_speed_percent = ctx.timing->GetDisplayedSpeedPercent(
+							position.m_fSongBeatVisible,
+							position.m_fMusicSecondsVisible );
+	}
+	if( bTimeSpacing )
+	{
+		ctx.song_seconds = pPlayerState->m_Position.m_fMusicSecondsVisible;
+		float fBPM = curr_options->m_fScrollBPM;
+		ctx.time_spacing_bps = fBPM/60.f / GAMESTATE->m_SongOptions.GetCurrent().m_fMusicRate;
+	}
+
+	// TODO: If we allow noteskins to have metricable row spacing
+	// (per issue 24), edit this to reflect that. -aj
+	ctx.arrow_spacing = ARROW_SPACING;
+
+	// Factor in scroll speed
+	ctx.scroll_speed = curr_options->m_fScrollSpeed;
+	if(curr_options->m_fMaxScrollBPM != 0)
 	{
-		int m = ( l + r ) / 2;
-		if( ( m == 0 || data[m].beat <= beat ) && ( m == max || beat < data[m + 1].beat ) )
-		{
-			return data[m].displayedBeat + data[m].velocity * (beat - data[m].beat);
-		}
-		else if( data[m].beat <= beat )
-		{
-			l = m + 1;
-		}
-		else
-		{
-			r = m - 1;
-		}
+		ctx.scroll_speed= curr_options->m_fMaxScrollBPM /
+			(pPlayerState->m_fReadBPM * GAMESTATE->m_SongOptions.GetCurrent().m_fMusicRate);
 	}
-	return beat;
+
+	ctx.expand_speed = 1;
+	if( fAccels[PlayerOptions::ACCEL_EXPAND] != 0 )
+	{
+		ctx.expand_speed = SCALE( fAccels[PlayerOptions::ACCEL_EXPAND],
+				      EXPAND_SPEED_SCALE_FROM_LOW, EXPAND_SPEED_SCALE_FROM_HIGH,
+				      EXPAND_SPEED_SCALE_TO_LOW, data.m_fExpandMultiplier );
+	}
+
+	ctx.tan_expand_speed = 1;
+	if( fAccels[PlayerOptions::ACCEL_TAN_EXPAND] != 0 )
+	{
+		ctx.tan_expand_speed = SCALE( fAccels[PlayerOptions::ACCEL_TAN_EXPAND],
+				      EXPAND_SPEED_SCALE_FROM_LOW, EXPAND_SPEED_SCALE_FROM_HIGH,
+				      EXPAND_SPEED_SCALE_TO_LOW, data.m_fTanExpandMultiplier );
+	}
+
+	ctx.note_field_height = GetNoteFieldHeight();
 }
 
 /* For visibility testing: if bAbsolute is false, random modifiers must return
  * the minimum possible scroll speed. */
-float ArrowEffects::GetYOffset( const PlayerState* pPlayerState, int iCol, float fNoteBeat, float &fPeakYOffsetOut, bool &bIsPastPeakOut, bool bAbsolute )
+static float CalcYOffset( YOffsetContext &ctx, int iCol, float fNoteBeat, float &fPeakYOffsetOut, bool &bIsPastPeakOut, bool bAbsolute )
 {
 	// Default values that are returned if boomerang is off.
 	fPeakYOffsetOut = FLT_MAX;
 	bIsPastPeakOut = true;
 
 	float fYOffset = 0;
-	const SongPosition &position = pPlayerState->GetDisplayedPosition();
-
-	float fSongBeat = position.m_fSongBeatVisible;
-
-	Steps *pCurSteps = GAMESTATE->m_pCurSteps[pPlayerState->m_PlayerNumber];
 
 	/* Usually, fTimeSpacing is 0 or 1, in which case we use entirely beat spacing or
 	 * entirely time spacing (respectively). Occasionally, we tween between them. */
 	if( curr_options->m_fTimeSpacing != 1.0f )
 	{
-		if( GAMESTATE->m_bInStepEditor ) {
+		if( ctx.in_step_editor ) {
 			// Use constant spacing in step editor
-			fYOffset = fNoteBeat - fSongBeat;
+			fYOffset = fNoteBeat - ctx.song_beat;
 		} else {
-			fYOffset = GetDisplayedBeat(pPlayerState, fNoteBeat) - GetDisplayedBeat(pPlayerState, fSongBeat);
-			fYOffset *= pCurSteps->GetTimingData()->GetDisplayedSpeedPercent(
-								     position.m_fSongBeatVisible,
-								     position.m_fMusicSecondsVisible );
+			fYOffset = ctx.displayed_timing->GetDisplayedBeat(fNoteBeat, ctx.displayed_beat_cursor) - ctx.displayed_song_beat;
+			fYOffset *= ctx.displayed_speed_percent;
 		}
 		fYOffset *= 1 - curr_options->m_fTimeSpacing;
 	}
 
 	if( curr_options->m_fTimeSpacing != 0.0f )
 	{
-		float fSongSeconds = pPlayerState->m_Position.m_fMusicSecondsVisible;
-		float fNoteSeconds = pCurSteps->GetTimingData()->GetElapsedTimeFromBeat(fNoteBeat);
-		float fSecondsUntilStep = fNoteSeconds - fSongSeconds;
-		float fBPM = curr_options->m_fScrollBPM;
-		float fBPS = fBPM/60.f / GAMESTATE->m_SongOptions.GetCurrent().m_fMusicRate;
-		float fYOffsetTimeSpacing = fSecondsUntilStep * fBPS;
+		float fNoteSeconds = ctx.timing->GetElapsedTimeFromBeat(fNoteBeat);
+		float fSecondsUntilStep = fNoteSeconds - ctx.song_seconds;
+		float fYOffsetTimeSpacing = fSecondsUntilStep * ctx.time_spacing_bps;
 		fYOffset += fYOffsetTimeSpacing * curr_options->m_fTimeSpacing;
 	}
 
-	// TODO: If we allow noteskins to have metricable row spacing
-	// (per issue 24), edit this to reflect that. -aj
-	fYOffset *= ARROW_SPACING;
+	fYOffset *= ctx.arrow_spacing;
 
-	// Factor in scroll speed
-	float fScrollSpeed = curr_options->m_fScrollSpeed;
-	if(curr_options->m_fMaxScrollBPM != 0)
-	{
-		fScrollSpeed= curr_options->m_fMaxScrollBPM /
-			(pPlayerState->m_fReadBPM * GAMESTATE->m_SongOptions.GetCurrent().m_fMusicRate);
-	}
+	float fScrollSpeed = ctx.scroll_speed;
 
 	// don't mess with the arrows after they've crossed 0
 	if( fYOffset < 0 )
@@ -522,14 +714,11 @@ float ArrowEffects::GetYOffset( const PlayerState* pPlayerState, int iCol, float
 	const float* fAccels = curr_options->m_fAccels;
 	const float* fEffects = curr_options->m_fEffects;
 
-	// TODO: Don't index by PlayerNumber.
-	PerPlayerData &data = g_EffectData[pPlayerState->m_PlayerNumber];
-
 	float fYAdjust = 0;	// fill this in depending on PlayerOptions
 
 	if( fAccels[PlayerOptions::ACCEL_BOOST] != 0 )
 	{
-		float fEffectHeight = GetNoteFieldHeight();
+		float fEffectHeight = ctx.note_field_height;
 		float fNewYOffset = fYOffset * 1.5f / ((fYOffset+fEffectHeight/1.2f)/fEffectHeight);
 		float fAccelYAdjust =	fAccels[PlayerOptions::ACCEL_BOOST] * (fNewYOffset - fYOffset);
 		// TRICKY: Clamp this value, or else BOOST+BOOMERANG will draw a ton of arrows on the screen.
@@ -538,7 +727,7 @@ float ArrowEffects::GetYOffset( const PlayerState* pPlayerState, int iCol, float
 	}
 	if( fAccels[PlayerOptions::ACCEL_BRAKE] != 0 )
 	{
-		float fEffectHeight = GetNoteFieldHeight();
+		float fEffectHeight = ctx.note_field_height;
 		float fScale = SCALE( fYOffset, 0.f, fEffectHeight, 0, 1.f );
 		float fNewYOffset = fYOffset * fScale;
 		float fBrakeYAdjust = fAccels[PlayerOptions::ACCEL_BRAKE] * (fNewYOffset - fYOffset);
@@ -581,25 +770,8 @@ float ArrowEffects::GetYOffset( const PlayerState* pPlayerState, int iCol, float
 						1.0f, curr_options->m_fRandomSpeed + 1.0f );
 	}
 
-	if( fAccels[PlayerOptions::ACCEL_EXPAND] != 0 )
-	{
-		float fExpandMultiplier = SCALE( RageFastCos(data.m_fExpandSeconds*EXPAND_MULTIPLIER_FREQUENCY*(fAccels[PlayerOptions::ACCEL_EXPAND_PERIOD]+1)),
-						EXPAND_MULTIPLIER_SCALE_FROM_LOW, EXPAND_MULTIPLIER_SCALE_FROM_HIGH,
-						EXPAND_MULTIPLIER_SCALE_TO_LOW, EXPAND_MULTIPLIER_SCALE_TO_HIGH );
-		fScrollSpeed *=	SCALE( fAccels[PlayerOptions::ACCEL_EXPAND],
-				      EXPAND_SPEED_SCALE_FROM_LOW, EXPAND_SPEED_SCALE_FROM_HIGH,
-				      EXPAND_SPEED_SCALE_TO_LOW, fExpandMultiplier );
-	}
-
-	if( fAccels[PlayerOptions::ACCEL_TAN_EXPAND] != 0 )
-	{
-		float fTanExpandMultiplier = SCALE( SelectTanType(data.m_fTanExpandSeconds*EXPAND_MULTIPLIER_FREQUENCY*(fAccels[PlayerOptions::ACCEL_TAN_EXPAND_PERIOD]+1), curr_options->m_bCosecant),
-						EXPAND_MULTIPLIER_SCALE_FROM_LOW, EXPAND_MULTIPLIER_SCALE_FROM_HIGH,
-						EXPAND_MULTIPLIER_SCALE_TO_LOW, EXPAND_MULTIPLIER_SCALE_TO_HIGH );
-		fScrollSpeed *=	SCALE( fAccels[PlayerOptions::ACCEL_TAN_EXPAND],
-				      EXPAND_SPEED_SCALE_FROM_LOW, EXPAND_SPEED_SCALE_FROM_HIGH,
-				      EXPAND_SPEED_SCALE_TO_LOW, fTanExpandMultiplier );
-	}
+	fScrollSpeed *= ctx.expand_speed;
+	fScrollSpeed *= ctx.tan_expand_speed;
 
 	fYOffset *= fScrollSpeed;
 	fPeakYOffsetOut *= fScrollSpeed;
@@ -607,6 +779,23 @@ float ArrowEffects::GetYOffset( const PlayerState* pPlayerState, int iCol, float
 	return fYOffset;
 }
 
+float ArrowEffects::GetYOffset( const PlayerState* pPlayerState, int iCol, float fNoteBeat, float &fPeakYOffsetOut, bool &bIsPastPeakOut, bool bAbsolute )
+{
+	YOffsetContext ctx;
+	PrepareYOffsetContext( pPlayerState, ctx );
+	return CalcYOffset( ctx, iCol, fNoteBeat, fPeakYOffsetOut, bIsPastPeakOut, bAbsolute );
+}
+
+void ArrowEffects::GetYOffsets( const PlayerState* pPlayerState, int iCol, const float* pNoteBeats, float* pYOffsetsOut, int iCount, bool bAbsolute )
+{
+	YOffsetContext ctx;
+	PrepareYOffsetContext( pPlayerState, ctx );
+	float fPeakYOffset;
+	bool bIsPastPeak;
+	for( int i = 0; i < iCount; ++i )
+		pYOffsetsOut[i] = CalcYOffset( ctx, iCol, pNoteBeats[i], fPeakYOffset, bIsPastPeak, bAbsolute );
+}
+
 static void ArrowGetReverseShiftAndScale(int iCol, float fYReverseOffsetPixels, float &fShiftOut, float &fScaleOut)
 {
 	// XXX: Hack: we need to scale the reverse shift by the zoom.
@@ -625,17 +814,20 @@ static void ArrowGetReverseShiftAndScale(int iCol, float fYReverseOffsetPixels,
 	fScaleOut = SCALE( fPercentReverse, 0.f, 1.f, 1.f, -1.f );
 }
 
-float ArrowEffects::GetYPos( const PlayerState* pPlayerState, int iCol, float fYOffset, float fYReverseOffsetPixels, bool WithReverse)
+static void CalcYPositions( const PlayerState* pPlayerState, int iCol, const float* pYOffsets, float fYReverseOffsetPixels, bool WithReverse, float* pYOut, int iCount )
 {
-	float f = fYOffset;
-
 	if( WithReverse )
 	{
 		float fShift, fScale;
 		ArrowGetReverseShiftAndScale(iCol, fYReverseOffsetPixels, fShift, fScale);
 
-		f *= fScale;
-		f += fShift;
+		for( int i = 0; i < iCount; ++i )
+			pYOut[i] = pYOffsets[i] * fScale + fShift;
+	}
+	else
+	{
+		for( int i = 0; i < iCount; ++i )
+			pYOut[i] = pYOffsets[i];
 	}
 
 	// TODO: Don't index by PlayerNumber.
@@ -647,27 +839,38 @@ float ArrowEffects::GetYPos( const PlayerState* pPlayerState, int iCol, float fY
 	// checking whether tipsy is on. -Kyz
 	// TODO: Don't index by PlayerNumber.
 	PerPlayerData& data= g_EffectData[curr_options->m_pn];
-	f+= fEffects[PlayerOptions::EFFECT_TIPSY] * data.m_tipsy_result[iCol];
-	f+= fEffects[PlayerOptions::EFFECT_TAN_TIPSY] * data.m_tan_tipsy_result[iCol];
+	AddConstantOffset(fEffects[PlayerOptions::EFFECT_TIPSY] * data.m_tipsy_result[iCol], pYOut, iCount);
+	AddConstantOffset(fEffects[PlayerOptions::EFFECT_TAN_TIPSY] * data.m_tan_tipsy_result[iCol], pYOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_ATTENUATE_Y] != 0 )
 	{
-		const float fXOffset = pCols[iCol].fXOffset;
-		f += fEffects[PlayerOptions::EFFECT_ATTENUATE_Y] * (fYOffset/ARROW_SIZE) * (fYOffset/ARROW_SIZE) * (fXOffset/ARROW_SIZE);
+		AddParabolaOffsets(fEffects[PlayerOptions::EFFECT_ATTENUATE_Y],
+			pCols[iCol].fXOffset/ARROW_SIZE, pYOffsets, pYOut, iCount);
 	}
 
-
 	if( fEffects[PlayerOptions::EFFECT_BEAT_Y] != 0 )
 	{
-		const float fShift = data.m_fBeatFactor[dim_y]*RageFastSin( fYOffset / ((fEffects[PlayerOptions::EFFECT_BEAT_Y_PERIOD]*BEAT_Y_OFFSET_HEIGHT)+BEAT_Y_OFFSET_HEIGHT) + PI/BEAT_Y_PI_HEIGHT );
-		f += fEffects[PlayerOptions::EFFECT_BEAT_Y] * fShift;
+		AddBeatOffsets(fEffects[PlayerOptions::EFFECT_BEAT_Y], data.m_fBeatFactor[dim_y],
+			fEffects[PlayerOptions::EFFECT_BEAT_Y_PERIOD], BEAT_Y_OFFSET_HEIGHT,
+			BEAT_Y_PI_HEIGHT, pYOffsets, pYOut, iCount);
 	}
 
 	// In beware's DDR Extreme-focused fork of StepMania 3.9, this value is
 	// floored, making arrows show on integer Y coordinates. Supposedly it makes
 	// the arrows look better, but testing needs to be done.
 	// todo: make this a noteskin metric instead of a theme metric? -aj
-	return QUANTIZE_ARROW_Y ? std::floor(f) : f;
+	if( QUANTIZE_ARROW_Y )
+	{
+		for( int i = 0; i < iCount; ++i )
+			pYOut[i] = std::floor(pYOut[i]);
+	}
+}
+
+float ArrowEffects::GetYPos( const PlayerState* pPlayerState, int iCol, float fYOffset, float fYReverseOffsetPixels, bool WithReverse)
+{
+	float fYPos;
+	CalcYPositions( pPlayerState, iCol, &fYOffset, fYReverseOffsetPixels, WithReverse, &fYPos, 1 );
+	return fYPos;
 }
 
 float ArrowEffects::GetYOffsetFromYPos(int iCol, float YPos, float fYReverseOffsetPixels)
@@ -694,12 +897,14 @@ float ArrowEffects::GetYOffsetFromYPos(int iCol, float YPos, float fYReverseOffs
 	return f;
 }
 
-float ArrowEffects::GetXPos( const PlayerState* pPlayerState, int iColNum, float fYOffset )
+static void CalcXPositions( const PlayerState* pPlayerState, int iColNum, const float* pYOffsets, float* pXOut, int iCount )
 {
-	float fPixelOffsetFromCenter = 0; // fill this in below
+	for( int i = 0; i < iCount; ++i )
+		pXOut[i] = 0;
 
 	const Style* pStyle = GAMESTATE->GetCurrentStyle(pPlayerState->m_PlayerNumber);
 	const float* fEffects = curr_options->m_fEffects;
+	const float fFieldZoom = pPlayerState->m_NotefieldZoom;
 
 	// TODO: Don't index by PlayerNumber.
 	const Style::ColumnInfo* pCols = pStyle->m_ColumnInfo[pPlayerState->m_PlayerNumber];
@@ -707,125 +912,122 @@ float ArrowEffects::GetXPos( const PlayerState* pPlayerState, int iColNum, float
 
 	if( fEffects[PlayerOptions::EFFECT_TORNADO] != 0 )
 	{
-		fPixelOffsetFromCenter += CalculateTornadoOffsetFromMagnitude(dim_x,
-			iColNum, fEffects[PlayerOptions::EFFECT_TORNADO],
+		AddTornadoOffsets(dim_x, iColNum, fEffects[PlayerOptions::EFFECT_TORNADO],
 			fEffects[PlayerOptions::EFFECT_TORNADO_OFFSET],
 			fEffects[PlayerOptions::EFFECT_TORNADO_PERIOD],
-			pCols, pPlayerState->m_NotefieldZoom, data, fYOffset, false);
+			pCols, fFieldZoom, data, false, pYOffsets, pXOut, iCount);
 	}
 
 	if( fEffects[PlayerOptions::EFFECT_TAN_TORNADO] != 0 )
 	{
-		fPixelOffsetFromCenter += CalculateTornadoOffsetFromMagnitude(dim_x,
-			iColNum, fEffects[PlayerOptions::EFFECT_TAN_TORNADO],
+		AddTornadoOffsets(dim_x, iColNum, fEffects[PlayerOptions::EFFECT_TAN_TORNADO],
 			fEffects[PlayerOptions::EFFECT_TAN_TORNADO_OFFSET],
 			fEffects[PlayerOptions::EFFECT_TAN_TORNADO_PERIOD],
-			pCols, pPlayerState->m_NotefieldZoom, data, fYOffset, true);
+			pCols, fFieldZoom, data, true, pYOffsets, pXOut, iCount);
 	}
 
 	if( fEffects[PlayerOptions::EFFECT_BUMPY_X] != 0 )
-		fPixelOffsetFromCenter += fEffects[PlayerOptions::EFFECT_BUMPY_X] *
-			40*RageFastSin( CalculateBumpyAngle(fYOffset,
+		AddBumpyOffsets(fEffects[PlayerOptions::EFFECT_BUMPY_X],
 			fEffects[PlayerOptions::EFFECT_BUMPY_X_OFFSET],
-			fEffects[PlayerOptions::EFFECT_BUMPY_X_PERIOD]) );
+			fEffects[PlayerOptions::EFFECT_BUMPY_X_PERIOD], false,
+			pYOffsets, pXOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_TAN_BUMPY_X] != 0 )
-		fPixelOffsetFromCenter += fEffects[PlayerOptions::EFFECT_TAN_BUMPY_X] *
-			40*SelectTanType( CalculateBumpyAngle(fYOffset,
+		AddBumpyOffsets(fEffects[PlayerOptions::EFFECT_TAN_BUMPY_X],
 			fEffects[PlayerOptions::EFFECT_TAN_BUMPY_X_OFFSET],
-			fEffects[PlayerOptions::EFFECT_TAN_BUMPY_X_PERIOD]), curr_options->m_bCosecant );
+			fEffects[PlayerOptions::EFFECT_TAN_BUMPY_X_PERIOD], true,
+			pYOffsets, pXOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_DRUNK] != 0 )
-		fPixelOffsetFromCenter += fEffects[PlayerOptions::EFFECT_DRUNK] *
-			( RageFastCos( CalculateDrunkAngle(fEffects[PlayerOptions::EFFECT_DRUNK_SPEED], iColNum,
-					fEffects[PlayerOptions::EFFECT_DRUNK_OFFSET], DRUNK_COLUMN_FREQUENCY,
-					fYOffset, fEffects[PlayerOptions::EFFECT_DRUNK_PERIOD],
-					DRUNK_OFFSET_FREQUENCY) ) * ARROW_SIZE*DRUNK_ARROW_MAGNITUDE );
+		AddDrunkOffsets(fEffects[PlayerOptions::EFFECT_DRUNK],
+			fEffects[PlayerOptions::EFFECT_DRUNK_SPEED], iColNum,
+			fEffects[PlayerOptions::EFFECT_DRUNK_OFFSET], DRUNK_COLUMN_FREQUENCY,
+			fEffects[PlayerOptions::EFFECT_DRUNK_PERIOD], DRUNK_OFFSET_FREQUENCY,
+			DRUNK_ARROW_MAGNITUDE, ArrowEffects::GetTime(), false,
+			pYOffsets, pXOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_TAN_DRUNK] != 0 )
-		fPixelOffsetFromCenter += fEffects[PlayerOptions::EFFECT_TAN_DRUNK] *
-			( SelectTanType( CalculateDrunkAngle(fEffects[PlayerOptions::EFFECT_TAN_DRUNK_SPEED],
-					iColNum, fEffects[PlayerOptions::EFFECT_TAN_DRUNK_OFFSET],
-					DRUNK_COLUMN_FREQUENCY, fYOffset,
-					fEffects[PlayerOptions::EFFECT_TAN_DRUNK_PERIOD], DRUNK_OFFSET_FREQUENCY)
-					, curr_options->m_bCosecant) * ARROW_SIZE*DRUNK_ARROW_MAGNITUDE );
+		AddDrunkOffsets(fEffects[PlayerOptions::EFFECT_TAN_DRUNK],
+			fEffects[PlayerOptions::EFFECT_TAN_DRUNK_SPEED], iColNum,
+			fEffects[PlayerOptions::EFFECT_TAN_DRUNK_OFFSET], DRUNK_COLUMN_FREQUENCY,
+			fEffects[PlayerOptions::EFFECT_TAN_DRUNK_PERIOD], DRUNK_OFFSET_FREQUENCY,
+			DRUNK_ARROW_MAGNITUDE, ArrowEffects::GetTime(), true,
+			pYOffsets, pXOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_FLIP] != 0 )
 	{
 		const int iFirstCol = 0;
 		const int iLastCol = pStyle->m_iColsPerPlayer-1;
 		const int iNewCol = SCALE( iColNum, iFirstCol, iLastCol, iLastCol, iFirstCol );
-		const float fOldPixelOffset = pCols[iColNum].fXOffset * pPlayerState->m_NotefieldZoom;
-		const float fNewPixelOffset = pCols[iNewCol].fXOffset * pPlayerState->m_NotefieldZoom;
+		const float fOldPixelOffset = pCols[iColNum].fXOffset * fFieldZoom;
+		const float fNewPixelOffset = pCols[iNewCol].fXOffset * fFieldZoom;
 		const float fDistance = fNewPixelOffset - fOldPixelOffset;
-		fPixelOffsetFromCenter += fDistance * fEffects[PlayerOptions::EFFECT_FLIP];
+		AddConstantOffset(fDistance * fEffects[PlayerOptions::EFFECT_FLIP], pXOut, iCount);
 	}
 	if( fEffects[PlayerOptions::EFFECT_INVERT] != 0 )
-		fPixelOffsetFromCenter += data.m_fInvertDistance[iColNum] * fEffects[PlayerOptions::EFFECT_INVERT];
+		AddConstantOffset(data.m_fInvertDistance[iColNum] * fEffects[PlayerOptions::EFFECT_INVERT], pXOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_BEAT] != 0 )
 	{
-		const float fShift = data.m_fBeatFactor[dim_x]*RageFastSin( fYOffset / ((fEffects[PlayerOptions::EFFECT_BEAT_PERIOD]*BEAT_OFFSET_HEIGHT)+BEAT_OFFSET_HEIGHT) + PI/BEAT_PI_HEIGHT );
-		fPixelOffsetFromCenter += fEffects[PlayerOptions::EFFECT_BEAT] * fShift;
+		AddBeatOffsets(fEffects[PlayerOptions::EFFECT_BEAT], data.m_fBeatFactor[dim_x],
+			fEffects[PlayerOptions::EFFECT_BEAT_PERIOD], BEAT_OFFSET_HEIGHT,
+			BEAT_PI_HEIGHT, pYOffsets, pXOut, iCount);
 	}
 
 	if( fEffects[PlayerOptions::EFFECT_ZIGZAG] != 0 )
 	{
-		float fResult = RageTriangle( (PI * (1/(fEffects[PlayerOptions::EFFECT_ZIGZAG_PERIOD]+1)) *
-		((fYOffset+(100.0f*(fEffects[PlayerOptions::EFFECT_ZIGZAG_OFFSET])))/ARROW_SIZE) ) );
-
-		fPixelOffsetFromCenter += (fEffects[PlayerOptions::EFFECT_ZIGZAG]*ARROW_SIZE/2) * fResult;
+		AddZigZagOffsets(fEffects[PlayerOptions::EFFECT_ZIGZAG],
+			fEffects[PlayerOptions::EFFECT_ZIGZAG_OFFSET],
+			fEffects[PlayerOptions::EFFECT_ZIGZAG_PERIOD], pYOffsets, pXOut, iCount);
 	}
 
 	if( fEffects[PlayerOptions::EFFECT_SAWTOOTH] != 0 )
-		fPixelOffsetFromCenter += (fEffects[PlayerOptions::EFFECT_SAWTOOTH]*ARROW_SIZE) *
-			((0.5f / (fEffects[PlayerOptions::EFFECT_SAWTOOTH_PERIOD]+1) * fYOffset) / ARROW_SIZE -
-			std::floor((0.5f / (fEffects[PlayerOptions::EFFECT_SAWTOOTH_PERIOD]+1) * fYOffset) / ARROW_SIZE) );
+		AddSawtoothOffsets(fEffects[PlayerOptions::EFFECT_SAWTOOTH],
+			fEffects[PlayerOptions::EFFECT_SAWTOOTH_PERIOD], pYOffsets, pXOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_PARABOLA_X] != 0 )
-		fPixelOffsetFromCenter += fEffects[PlayerOptions::EFFECT_PARABOLA_X] * (fYOffset/ARROW_SIZE) * (fYOffset/ARROW_SIZE);
+		AddParabolaOffsets(fEffects[PlayerOptions::EFFECT_PARABOLA_X], 1.0f,
+			pYOffsets, pXOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_ATTENUATE_X] != 0 )
 	{
-		const float fXOffset = pCols[iColNum].fXOffset;
-		fPixelOffsetFromCenter += fEffects[PlayerOptions::EFFECT_ATTENUATE_X] * (fYOffset/ARROW_SIZE) * (fYOffset/ARROW_SIZE) * (fXOffset/ARROW_SIZE);
+		AddParabolaOffsets(fEffects[PlayerOptions::EFFECT_ATTENUATE_X],
+			pCols[iColNum].fXOffset/ARROW_SIZE, pYOffsets, pXOut, iCount);
 	}
 
 	if( fEffects[PlayerOptions::EFFECT_DIGITAL] != 0 )
-		fPixelOffsetFromCenter += (fEffects[PlayerOptions::EFFECT_DIGITAL] * ARROW_SIZE * 0.5f) *
-			std::round((fEffects[PlayerOptions::EFFECT_DIGITAL_STEPS]+1) * RageFastSin(
-				CalculateDigitalAngle(fYOffset,
-				fEffects[PlayerOptions::EFFECT_DIGITAL_OFFSET],
-				fEffects[PlayerOptions::EFFECT_DIGITAL_PERIOD]) ) )/(fEffects[PlayerOptions::EFFECT_DIGITAL_STEPS]+1);
+		AddDigitalOffsets(fEffects[PlayerOptions::EFFECT_DIGITAL],
+			fEffects[PlayerOptions::EFFECT_DIGITAL_STEPS],
+			fEffects[PlayerOptions::EFFECT_DIGITAL_OFFSET],
+			fEffects[PlayerOptions::EFFECT_DIGITAL_PERIOD], false,
+			pYOffsets, pXOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_TAN_DIGITAL] != 0 )
-		fPixelOffsetFromCenter += (fEffects[PlayerOptions::EFFECT_TAN_DIGITAL] * ARROW_SIZE * 0.5f) *
-			std::round((fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_STEPS]+1) * SelectTanType(
-				CalculateDigitalAngle(fYOffset,
-				fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_OFFSET],
-				fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_PERIOD]), curr_options->m_bCosecant ) )/(fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_STEPS]+1);
-
+		AddDigitalOffsets(fEffects[PlayerOptions::EFFECT_TAN_DIGITAL],
+			fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_STEPS],
+			fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_OFFSET],
+			fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_PERIOD], true,
+			pYOffsets, pXOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_SQUARE] != 0 )
 	{
-		float fResult = RageSquare( (PI * (fYOffset+(1.0f*(fEffects[PlayerOptions::EFFECT_SQUARE_OFFSET]))) /
-			(ARROW_SIZE+(fEffects[PlayerOptions::EFFECT_SQUARE_PERIOD]*ARROW_SIZE))) );
-
-		fPixelOffsetFromCenter += (fEffects[PlayerOptions::EFFECT_SQUARE] * ARROW_SIZE * 0.5f) * fResult;
+		AddSquareOffsets(fEffects[PlayerOptions::EFFECT_SQUARE],
+			fEffects[PlayerOptions::EFFECT_SQUARE_OFFSET],
+			fEffects[PlayerOptions::EFFECT_SQUARE_PERIOD], pYOffsets, pXOut, iCount);
 	}
 
 	if( fEffects[PlayerOptions::EFFECT_BOUNCE] != 0 )
 	{
-		float fBounceAmt = std::abs( RageFastSin( ( (fYOffset + (1.0f * (fEffects[PlayerOptions::EFFECT_BOUNCE_OFFSET]) ) ) /
-			( 60 + (fEffects[PlayerOptions::EFFECT_BOUNCE_PERIOD]*60) ) ) ) );
-
-		fPixelOffsetFromCenter += fEffects[PlayerOptions::EFFECT_BOUNCE] * ARROW_SIZE * 0.5f * fBounceAmt;
+		AddBounceOffsets(fEffects[PlayerOptions::EFFECT_BOUNCE],
+			fEffects[PlayerOptions::EFFECT_BOUNCE_OFFSET],
+			fEffects[PlayerOptions::EFFECT_BOUNCE_PERIOD], pYOffsets, pXOut, iCount);
 	}
 
 	if( fEffects[PlayerOptions::EFFECT_XMODE] != 0 )
 	{
 		// based off of code by v1toko for StepNXA, except it should work on
 		// any gametype now.
+		bool bMoveLeft = false;
 		switch( pStyle->m_StyleType )
 		{
 			case StyleType_OnePlayerTwoSides:
@@ -834,91 +1036,138 @@ float ArrowEffects::GetXPos( const PlayerState* pPlayerState, int iColNum, float
 					// find the middle, and split based on iColNum
 					// it's unknown if this will work for routine.
 					const int iMiddleColumn = std::floor(pStyle->m_iColsPerPlayer/2.0f);
-					if( iColNum > iMiddleColumn-1 )
-						fPixelOffsetFromCenter += fEffects[PlayerOptions::EFFECT_XMODE]*-(fYOffset);
-					else
-						fPixelOffsetFromCenter += fEffects[PlayerOptions::EFFECT_XMODE]*fYOffset;
+					bMoveLeft = iColNum > iMiddleColumn-1;
 				}
 				break;
 			case StyleType_OnePlayerOneSide:
 			case StyleType_TwoPlayersTwoSides:
 				{
 					// the code was the same for both of these cases in StepNXA.
-					if( pPlayerState->m_PlayerNumber == PLAYER_2 )
-						fPixelOffsetFromCenter += fEffects[PlayerOptions::EFFECT_XMODE]*-(fYOffset);
-					else
-						fPixelOffsetFromCenter += fEffects[PlayerOptions::EFFECT_XMODE]*fYOffset;
+					bMoveLeft = pPlayerState->m_PlayerNumber == PLAYER_2;
 				}
 				break;
 			DEFAULT_FAIL(pStyle->m_StyleType);
 		}
+		const float fXMode = fEffects[PlayerOptions::EFFECT_XMODE];
+		for( int i = 0; i < iCount; ++i )
+			pXOut[i] += bMoveLeft ? fXMode*-(pYOffsets[i]) : fXMode*pYOffsets[i];
 	}
 
-	fPixelOffsetFromCenter += pCols[iColNum].fXOffset * pPlayerState->m_NotefieldZoom;
+	AddConstantOffset(pCols[iColNum].fXOffset * fFieldZoom, pXOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_TINY] != 0 )
 	{
 		// Allow Tiny to pull tracks together, but not to push them apart.
 		float fTinyPercent = fEffects[PlayerOptions::EFFECT_TINY];
 		fTinyPercent = std::min( std::pow(TINY_PERCENT_BASE, fTinyPercent), (float)TINY_PERCENT_GATE );
-		fPixelOffsetFromCenter *= fTinyPercent;
+		for( int i = 0; i < iCount; ++i )
+			pXOut[i] *= fTinyPercent;
 	}
+}
 
-	return fPixelOffsetFromCenter;
+float ArrowEffects::GetXPos( const PlayerState* pPlayerState, int iColNum, float fYOffset )
+{
+	float fXPos;
+	CalcXPositions( pPlayerState, iColNum, &fYOffset, &fXPos, 1 );
+	return fXPos;
 }
 
-float ArrowEffects::GetRotationX(const PlayerState* pPlayerState, float fYOffset, bool bIsHoldCap, int iCol)
+// Each axis is worked out on its own, so the single note functions only do
+// the work for the axis they return.  Confusion is the same for every note in
+// the column.
+static void CalcRotationsX( const PlayerState* pPlayerState, int iCol, const float* pYOffsets, float* pRotOut, int iCount, bool bIsHoldCap )
 {
 	const float* fEffects = curr_options->m_fEffects;
-	float fRotation = 0;
+	float fBase = 0;
 	if( fEffects[PlayerOptions::EFFECT_CONFUSION_X] != 0 || fEffects[PlayerOptions::EFFECT_CONFUSION_X_OFFSET] != 0 ||
 	curr_options->m_fConfusionX[iCol] != 0
 	)
-		fRotation += ReceptorGetRotationX( pPlayerState, iCol );
+		fBase += ArrowEffects::ReceptorGetRotationX( pPlayerState, iCol );
+	for( int i = 0; i < iCount; ++i )
+		pRotOut[i] = fBase;
+
 	if( fEffects[PlayerOptions::EFFECT_ROLL] != 0 && !bIsHoldCap )
 	{
-		fRotation += fEffects[PlayerOptions::EFFECT_ROLL] * fYOffset/2;
+		const float fRoll = fEffects[PlayerOptions::EFFECT_ROLL];
+		for( int i = 0; i < iCount; ++i )
+			pRotOut[i] += fRoll * pYOffsets[i]/2;
 	}
-	return fRotation;
 }
 
-float ArrowEffects::GetRotationY(const PlayerState* pPlayerState, float fYOffset, int iCol)
+static void CalcRotationsY( const PlayerState* pPlayerState, int iCol, const float* pYOffsets, float* pRotOut, int iCount )
 {
 	const float* fEffects = curr_options->m_fEffects;
-	float fRotation = 0;
+	float fBase = 0;
 	if( fEffects[PlayerOptions::EFFECT_CONFUSION_Y] != 0 || fEffects[PlayerOptions::EFFECT_CONFUSION_Y_OFFSET] != 0 ||
 	curr_options->m_fConfusionY[iCol] != 0
 	)
-		fRotation += ReceptorGetRotationY( pPlayerState, iCol );
+		fBase += ArrowEffects::ReceptorGetRotationY( pPlayerState, iCol );
+	for( int i = 0; i < iCount; ++i )
+		pRotOut[i] = fBase;
+
 	if( fEffects[PlayerOptions::EFFECT_TWIRL] != 0 )
 	{
-		fRotation += fEffects[PlayerOptions::EFFECT_TWIRL] * fYOffset/2;
+		const float fTwirl = fEffects[PlayerOptions::EFFECT_TWIRL];
+		for( int i = 0; i < iCount; ++i )
+			pRotOut[i] += fTwirl * pYOffsets[i]/2;
 	}
-	return fRotation;
 }
 
-float ArrowEffects::GetRotationZ( const PlayerState* pPlayerState, float fNoteBeat, bool bIsHoldHead, int iCol )
+static void CalcRotationsZ( const PlayerState* pPlayerState, int iCol, const float* pNoteBeats, float* pRotOut, int iCount, bool bIsHoldHead )
 {
 	const float* fEffects = curr_options->m_fEffects;
-	float fRotation = 0;
+	float fBase = 0;
 	if( fEffects[PlayerOptions::EFFECT_CONFUSION] != 0 || fEffects[PlayerOptions::EFFECT_CONFUSION_OFFSET] != 0 ||
 	curr_options->m_fConfusionZ[iCol] != 0
 	)
-		fRotation += ReceptorGetRotationZ( pPlayerState, iCol );
+		fBase += ArrowEffects::ReceptorGetRotationZ( pPlayerState, iCol );
+	for( int i = 0; i < iCount; ++i )
+		pRotOut[i] = fBase;
 
 	// As usual, enable dizzy hold heads at your own risk. -Wolfman2000
 	if( fEffects[PlayerOptions::EFFECT_DIZZY] != 0 && ( curr_options->m_bDizzyHolds || !bIsHoldHead ) )
 	{
 		const float fSongBeat = pPlayerState->m_Position.m_fSongBeatVisible;
-		float fDizzyRotation = fNoteBeat - fSongBeat;
-		fDizzyRotation *= fEffects[PlayerOptions::EFFECT_DIZZY];
-		fDizzyRotation = std::fmod( fDizzyRotation, 2*PI );
-		fDizzyRotation *= 180/PI;
-		fRotation += fDizzyRotation;
+		const float fDizzy = fEffects[PlayerOptions::EFFECT_DIZZY];
+		for( int i = 0; i < iCount; ++i )
+		{
+			float fDizzyRotation = pNoteBeats[i] - fSongBeat;
+			fDizzyRotation *= fDizzy;
+			fDizzyRotation = std::fmod( fDizzyRotation, 2*PI );
+			fDizzyRotation *= 180/PI;
+			pRotOut[i] += fDizzyRotation;
+		}
 	}
+}
+
+float ArrowEffects::GetRotationX(const PlayerState* pPlayerState, float fYOffset, bool bIsHoldCap, int iCol)
+{
+	float fRotation;
+	CalcRotationsX( pPlayerState, iCol, &fYOffset, &fRotation, 1, bIsHoldCap );
 	return fRotation;
 }
 
+float ArrowEffects::GetRotationY(const PlayerState* pPlayerState, float fYOffset, int iCol)
+{
+	float fRotation;
+	CalcRotationsY( pPlayerState, iCol, &fYOffset, &fRotation, 1 );
+	return fRotation;
+}
+
+float ArrowEffects::GetRotationZ( const PlayerState* pPlayerState, float fNoteBeat, bool bIsHoldHead, int iCol )
+{
+	float fRotation;
+	CalcRotationsZ( pPlayerState, iCol, &fNoteBeat, &fRotation, 1, bIsHoldHead );
+	return fRotation;
+}
+
+void ArrowEffects::GetRotations( const PlayerState* pPlayerState, int iCol, const float* pNoteBeats, const float* pYOffsets, float* pRotXOut, float* pRotYOut, float* pRotZOut, int iCount, bool bIsHoldHead, bool bIsHoldCap )
+{
+	CalcRotationsX( pPlayerState, iCol, pYOffsets, pRotXOut, iCount, bIsHoldCap );
+	CalcRotationsY( pPlayerState, iCol, pYOffsets, pRotYOut, iCount );
+	CalcRotationsZ( pPlayerState, iCol, pNoteBeats, pRotZOut, iCount, bIsHoldHead );
+}
+
 float ArrowEffects::ReceptorGetRotationZ( const PlayerState* pPlayerState, int iCol )
 {
 	const float* fEffects = curr_options->m_fEffects;
@@ -1074,10 +1323,49 @@ static float GetSuddenStartLine()
 		GetCenterLine() * curr_options->m_fAppearances[PlayerOptions::APPEARANCE_SUDDEN_OFFSET];
 }
 
-// used by ArrowGetAlpha and ArrowGetGlow below
-float ArrowGetPercentVisible(float fYPosWithoutReverse, int iCol, float fYOffset)
+namespace
+{
+	// The parts of the visibility calculation that don't depend on the note.
+	struct VisibilityContext
+	{
+		float center_line;
+		float hidden_start_line;
+		float hidden_end_line;
+		float sudden_start_line;
+		float sudden_end_line;
+		float blink_adjust;
+	};
+};
+
+static void PrepareVisibilityContext( VisibilityContext &ctx )
+{
+	const float* fAppearances = curr_options->m_fAppearances;
+	ctx.center_line = GetCenterLine();
+	ctx.hidden_start_line = ctx.hidden_end_line = 0;
+	ctx.sudden_start_line = ctx.sudden_end_line = 0;
+	ctx.blink_adjust = 0;
+	if( fAppearances[PlayerOptions::APPEARANCE_HIDDEN] != 0 )
+	{
+		ctx.hidden_start_line = GetHiddenStartLine();
+		ctx.hidden_end_line = GetHiddenEndLine();
+	}
+	if( fAppearances[PlayerOptions::APPEARANCE_SUDDEN] != 0 )
+	{
+		ctx.sudden_start_line = GetSuddenStartLine();
+		ctx.sudden_end_line = GetSuddenEndLine();
+	}
+	if( fAppearances[PlayerOptions::APPEARANCE_BLINK] != 0 )
+	{
+		float f = RageFastSin(ArrowEffects::GetTime()*10);
+		f = Quantize( f, BLINK_MOD_FREQUENCY );
+		ctx.blink_adjust = SCALE( f, 0, 1, -1, 0 );
+	}
+}
+
+// used by GetAlphasAndGlows below
+static float GetPercentVisible(const VisibilityContext &ctx, float fYPosWithoutReverse, int iCol, float fYOffset)
 {
-	const float fDistFromCenterLine = fYPosWithoutReverse - GetCenterLine();
+	const float fDistFromCenterLine = fYPosWithoutReverse - ctx.center_line;
 
 	float fYPos;
 	if( curr_options->m_bStealthType )
@@ -1095,13 +1383,13 @@ float ArrowGetPercentVisible(float fYPosWithoutReverse, int iCol, float fYOffset
 
 	if( fAppearances[PlayerOptions::APPEARANCE_HIDDEN] != 0 )
 	{
-		float fHiddenVisibleAdjust = SCALE( fYPos, GetHiddenStartLine(), GetHiddenEndLine(), 0, -1 );
+		float fHiddenVisibleAdjust = SCALE( fYPos, ctx.hidden_start_line, ctx.hidden_end_line, 0, -1 );
 		CLAMP( fHiddenVisibleAdjust, -1, 0 );
 		fVisibleAdjust += fAppearances[PlayerOptions::APPEARANCE_HIDDEN] * fHiddenVisibleAdjust;
 	}
 	if( fAppearances[PlayerOptions::APPEARANCE_SUDDEN] != 0 )
 	{
-		float fSuddenVisibleAdjust = SCALE( fYPos, GetSuddenStartLine(), GetSuddenEndLine(), -1, 0 );
+		float fSuddenVisibleAdjust = SCALE( fYPos, ctx.sudden_start_line, ctx.sudden_end_line, -1, 0 );
 		CLAMP( fSuddenVisibleAdjust, -1, 0 );
 		fVisibleAdjust += fAppearances[PlayerOptions::APPEARANCE_SUDDEN] * fSuddenVisibleAdjust;
 	}
@@ -1113,9 +1401,7 @@ float ArrowGetPercentVisible(float fYPosWithoutReverse, int iCol, float fYOffset
 	}
 	if( fAppearances[PlayerOptions::APPEARANCE_BLINK] != 0 )
 	{
-		float f = RageFastSin(ArrowEffects::GetTime()*10);
-		f = Quantize( f, BLINK_MOD_FREQUENCY );
-		fVisibleAdjust += SCALE( f, 0, 1, -1, 0 );
+		fVisibleAdjust += ctx.blink_adjust;
 	}
 	if( fAppearances[PlayerOptions::APPEARANCE_RANDOMVANISH] != 0 )
 	{
@@ -1127,38 +1413,47 @@ float ArrowGetPercentVisible(float fYPosWithoutReverse, int iCol, float fYOffset
 	return clamp(1 + fVisibleAdjust, 0.0f, 1.0f);
 }
 
-float ArrowEffects::GetAlpha( const PlayerState* pPlayerState, int iCol, float fYOffset, float fPercentFadeToFail, float fYReverseOffsetPixels, float fDrawDistanceBeforeTargetsPixels, float fFadeInPercentOfDrawFar)
+void ArrowEffects::GetAlphasAndGlows( const PlayerState* pPlayerState, int iCol, const float* pYOffsets, const float* pPercentFadeToFail, float fYReverseOffsetPixels, float fDrawDistanceBeforeTargetsPixels, float fFadeInPercentOfDrawFar, float* pAlphasOut, float* pGlowsOut, int iCount )
 {
-	// Get the YPos without reverse (that is, factor in EFFECT_TIPSY).
-	float fYPosWithoutReverse = ArrowEffects::GetYPos(pPlayerState, iCol, fYOffset, fYReverseOffsetPixels, false );
+	// Get the YPos without reverse (that is, factor in EFFECT_TIPSY).  It's
+	// kept in the alpha array until the alpha replaces it.
+	float* pYPosWithoutReverse = pAlphasOut;
+	CalcYPositions( pPlayerState, iCol, pYOffsets, fYReverseOffsetPixels, false, pYPosWithoutReverse, iCount );
 
-	float fPercentVisible = ArrowGetPercentVisible(fYPosWithoutReverse, iCol, fYOffset);
+	VisibilityContext ctx;
+	PrepareVisibilityContext( ctx );
 
-	if( fPercentFadeToFail != -1 )
-		fPercentVisible = 1 - fPercentFadeToFail;
+	const float fFullAlphaY = fDrawDistanceBeforeTargetsPixels*(1-fFadeInPercentOfDrawFar);
+	for( int i = 0; i < iCount; ++i )
+	{
+		const float fYPos = pYPosWithoutReverse[i];
+		float fPercentVisible = GetPercentVisible(ctx, fYPos, iCol, pYOffsets[i]);
 
+		if( pPercentFadeToFail[i] != -1 )
+			fPercentVisible = 1 - pPercentFadeToFail[i];
 
-	float fFullAlphaY = fDrawDistanceBeforeTargetsPixels*(1-fFadeInPercentOfDrawFar);
-	if( fYPosWithoutReverse > fFullAlphaY )
-	{
-		float f = SCALE( fYPosWithoutReverse, fFullAlphaY, fDrawDistanceBeforeTargetsPixels, 1.0f, 0.0f );
-		return f;
+		const float fDistFromHalf = std::abs( fPercentVisible - 0.5f );
+		pGlowsOut[i] = SCALE( fDistFromHalf, 0, 0.5f, 1.3f, 0 );
+
+		if( fYPos > fFullAlphaY )
+			pAlphasOut[i] = SCALE( fYPos, fFullAlphaY, fDrawDistanceBeforeTargetsPixels, 1.0f, 0.0f );
+		else
+			pAlphasOut[i] = (fPercentVisible>0.5f) ? 1.0f : 0.0f;
 	}
-	return (fPercentVisible>0.5f) ? 1.0f : 0.0f;
 }
 
-float ArrowEffects::GetGlow( const PlayerState* pPlayerState, int iCol, float fYOffset, float fPercentFadeToFail, float fYReverseOffsetPixels, float fDrawDistanceBeforeTargetsPixels, float fFadeInPercentOfDrawFar)
+float ArrowEffects::GetAlpha( const PlayerState* pPlayerState, int iCol, float fYOffset, float fPercentFadeToFail, float fYReverseOffsetPixels, float fDrawDistanceBeforeTargetsPixels, float fFadeInPercentOfDrawFar)
 {
-	// Get the YPos without reverse (that is, factor in EFFECT_TIPSY).
-	float fYPosWithoutReverse = ArrowEffects::GetYPos(pPlayerState, iCol, fYOffset, fYReverseOffsetPixels, false );
-
-	float fPercentVisible = ArrowGetPercentVisible(fYPosWithoutReverse, iCol, fYOffset);
-
-	if( fPercentFadeToFail != -1 )
-		fPercentVisible = 1 - fPercentFadeToFail;
+	float fAlpha, fGlow;
+	GetAlphasAndGlows( pPlayerState, iCol, &fYOffset, &fPercentFadeToFail, fYReverseOffsetPixels, fDrawDistanceBeforeTargetsPixels, fFadeInPercentOfDrawFar, &fAlpha, &fGlow, 1 );
+	return fAlpha;
+}
 
-	const float fDistFromHalf = std::abs( fPercentVisible - 0.5f );
-	return SCALE( fDistFromHalf, 0, 0.5f, 1.3f, 0 );
+float ArrowEffects::GetGlow( const PlayerState* pPlayerState, int iCol, float fYOffset, float fPercentFadeToFail, float fYReverseOffsetPixels, float fDrawDistanceBeforeTargetsPixels, float fFadeInPercentOfDrawFar)
+{
+	float fAlpha, fGlow;
+	GetAlphasAndGlows( pPlayerState, iCol, &fYOffset, &fPercentFadeToFail, fYReverseOffsetPixels, fDrawDistanceBeforeTargetsPixels, fFadeInPercentOfDrawFar, &fAlpha, &fGlow, 1 );
+	return fGlow;
 }
 
 float ArrowEffects::GetBrightness( const PlayerState* pPlayerState, float fNoteBeat )
@@ -1175,11 +1470,14 @@ float ArrowEffects::GetBrightness( const PlayerState* pPlayerState, float fNoteB
 }
 
 
-float ArrowEffects::GetZPos( const PlayerState* pPlayerState, int iCol, float fYOffset)
+static void CalcZPositions( const PlayerState* pPlayerState, int iCol, const float* pYOffsets, float* pZOut, int iCount )
 {
-	float fZPos=0;
+	for( int i = 0; i < iCount; ++i )
+		pZOut[i] = 0;
+
 	const float* fEffects = curr_options->m_fEffects;
 	const Style* pStyle = GAMESTATE->GetCurrentStyle(pPlayerState->m_PlayerNumber);
+	const float fFieldZoom = pPlayerState->m_NotefieldZoom;
 
 	// TODO: Don't index by PlayerNumber.
 	const Style::ColumnInfo* pCols = pStyle->m_ColumnInfo[pPlayerState->m_PlayerNumber];
@@ -1187,117 +1485,135 @@ float ArrowEffects::GetZPos( const PlayerState* pPlayerState, int iCol, float fY
 
 	if( fEffects[PlayerOptions::EFFECT_TORNADO_Z] != 0 )
 	{
-		fZPos += CalculateTornadoOffsetFromMagnitude(dim_z, iCol,
-			fEffects[PlayerOptions::EFFECT_TORNADO_Z],
+		AddTornadoOffsets(dim_z, iCol, fEffects[PlayerOptions::EFFECT_TORNADO_Z],
 			fEffects[PlayerOptions::EFFECT_TORNADO_Z_OFFSET],
 			fEffects[PlayerOptions::EFFECT_TORNADO_Z_PERIOD],
-			pCols, pPlayerState->m_NotefieldZoom, data, fYOffset, false);
+			pCols, fFieldZoom, data, false, pYOffsets, pZOut, iCount);
 	}
 
 	if( fEffects[PlayerOptions::EFFECT_TAN_TORNADO_Z] != 0 )
 	{
-		fZPos += CalculateTornadoOffsetFromMagnitude(dim_z, iCol,
-			fEffects[PlayerOptions::EFFECT_TAN_TORNADO_Z],
+		AddTornadoOffsets(dim_z, iCol, fEffects[PlayerOptions::EFFECT_TAN_TORNADO_Z],
 			fEffects[PlayerOptions::EFFECT_TAN_TORNADO_Z_OFFSET],
 			fEffects[PlayerOptions::EFFECT_TAN_TORNADO_Z_PERIOD],
-			pCols, pPlayerState->m_NotefieldZoom, data, fYOffset, true);
+			pCols, fFieldZoom, data, true, pYOffsets, pZOut, iCount);
 	}
 
 	if( fEffects[PlayerOptions::EFFECT_BUMPY] != 0 )
-		fZPos += fEffects[PlayerOptions::EFFECT_BUMPY] * 40*RageFastSin(
-			CalculateBumpyAngle(fYOffset,
+		AddBumpyOffsets(fEffects[PlayerOptions::EFFECT_BUMPY],
 			fEffects[PlayerOptions::EFFECT_BUMPY_OFFSET],
-			fEffects[PlayerOptions::EFFECT_BUMPY_PERIOD]) );
+			fEffects[PlayerOptions::EFFECT_BUMPY_PERIOD], false,
+			pYOffsets, pZOut, iCount);
 
 	if( curr_options->m_fBumpy[iCol] != 0 )
-		fZPos += curr_options->m_fBumpy[iCol] * 40*RageFastSin(
-			CalculateBumpyAngle(fYOffset,
+		AddBumpyOffsets(curr_options->m_fBumpy[iCol],
 			fEffects[PlayerOptions::EFFECT_BUMPY_OFFSET],
-			fEffects[PlayerOptions::EFFECT_BUMPY_PERIOD]) );
+			fEffects[PlayerOptions::EFFECT_BUMPY_PERIOD], false,
+			pYOffsets, pZOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_TAN_BUMPY] != 0 )
-		fZPos += fEffects[PlayerOptions::EFFECT_TAN_BUMPY] * 40*SelectTanType(
-			CalculateBumpyAngle(fYOffset,
+		AddBumpyOffsets(fEffects[PlayerOptions::EFFECT_TAN_BUMPY],
 			fEffects[PlayerOptions::EFFECT_TAN_BUMPY_OFFSET],
-			fEffects[PlayerOptions::EFFECT_TAN_BUMPY_PERIOD]), curr_options->m_bCosecant );
+			fEffects[PlayerOptions::EFFECT_TAN_BUMPY_PERIOD], true,
+			pYOffsets, pZOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_ZIGZAG_Z] != 0 )
 	{
-		float fResult = RageTriangle( (PI * (1/(fEffects[PlayerOptions::EFFECT_ZIGZAG_Z_PERIOD]+1)) *
-			((fYOffset+(100.0f*(fEffects[PlayerOptions::EFFECT_ZIGZAG_Z_OFFSET])))/ARROW_SIZE) ) );
-
-		fZPos += (fEffects[PlayerOptions::EFFECT_ZIGZAG_Z]*ARROW_SIZE/2) * fResult;
+		AddZigZagOffsets(fEffects[PlayerOptions::EFFECT_ZIGZAG_Z],
+			fEffects[PlayerOptions::EFFECT_ZIGZAG_Z_OFFSET],
+			fEffects[PlayerOptions::EFFECT_ZIGZAG_Z_PERIOD], pYOffsets, pZOut, iCount);
 	}
 
 	if( fEffects[PlayerOptions::EFFECT_SAWTOOTH_Z] != 0 )
-		fZPos += (fEffects[PlayerOptions::EFFECT_SAWTOOTH_Z]*ARROW_SIZE) *
-			((0.5f/(fEffects[PlayerOptions::EFFECT_SAWTOOTH_Z_PERIOD]+1)*fYOffset)/ARROW_SIZE -
-				std::floor((0.5f/(fEffects[PlayerOptions::EFFECT_SAWTOOTH_Z_PERIOD]+1)*fYOffset)/ARROW_SIZE));
+		AddSawtoothOffsets(fEffects[PlayerOptions::EFFECT_SAWTOOTH_Z],
+			fEffects[PlayerOptions::EFFECT_SAWTOOTH_Z_PERIOD], pYOffsets, pZOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_PARABOLA_Z] != 0 )
-		fZPos += fEffects[PlayerOptions::EFFECT_PARABOLA_Z] * (fYOffset/ARROW_SIZE) * (fYOffset/ARROW_SIZE);
+		AddParabolaOffsets(fEffects[PlayerOptions::EFFECT_PARABOLA_Z], 1.0f,
+			pYOffsets, pZOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_ATTENUATE_Z] != 0 )
 	{
-		const float fXOffset = pCols[iCol].fXOffset;
-		fZPos += fEffects[PlayerOptions::EFFECT_ATTENUATE_Z] * (fYOffset/ARROW_SIZE) * (fYOffset/ARROW_SIZE) * (fXOffset/ARROW_SIZE);
+		AddParabolaOffsets(fEffects[PlayerOptions::EFFECT_ATTENUATE_Z],
+			pCols[iCol].fXOffset/ARROW_SIZE, pYOffsets, pZOut, iCount);
 	}
 
 	if( fEffects[PlayerOptions::EFFECT_DRUNK_Z] != 0 )
-		fZPos += fEffects[PlayerOptions::EFFECT_DRUNK_Z] *
-			( RageFastCos( CalculateDrunkAngle(fEffects[PlayerOptions::EFFECT_DRUNK_Z_SPEED], iCol,
-					fEffects[PlayerOptions::EFFECT_DRUNK_Z_OFFSET], DRUNK_Z_COLUMN_FREQUENCY,
-					fYOffset, fEffects[PlayerOptions::EFFECT_DRUNK_Z_PERIOD],
-					DRUNK_Z_OFFSET_FREQUENCY) ) * ARROW_SIZE*DRUNK_Z_ARROW_MAGNITUDE );
+		AddDrunkOffsets(fEffects[PlayerOptions::EFFECT_DRUNK_Z],
+			fEffects[PlayerOptions::EFFECT_DRUNK_Z_SPEED], iCol,
+			fEffects[PlayerOptions::EFFECT_DRUNK_Z_OFFSET], DRUNK_Z_COLUMN_FREQUENCY,
+			fEffects[PlayerOptions::EFFECT_DRUNK_Z_PERIOD], DRUNK_Z_OFFSET_FREQUENCY,
+			DRUNK_Z_ARROW_MAGNITUDE, ArrowEffects::GetTime(), false,
+			pYOffsets, pZOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_TAN_DRUNK_Z] != 0 )
-		fZPos += fEffects[PlayerOptions::EFFECT_TAN_DRUNK_Z] *
-			( SelectTanType( CalculateDrunkAngle(fEffects[PlayerOptions::EFFECT_TAN_DRUNK_Z_SPEED],
-					iCol, fEffects[PlayerOptions::EFFECT_TAN_DRUNK_Z_OFFSET],
-					DRUNK_Z_COLUMN_FREQUENCY, fYOffset,
-					fEffects[PlayerOptions::EFFECT_TAN_DRUNK_Z_PERIOD],
-					DRUNK_Z_OFFSET_FREQUENCY)
-					, curr_options->m_bCosecant) * ARROW_SIZE*DRUNK_Z_ARROW_MAGNITUDE );
+		AddDrunkOffsets(fEffects[PlayerOptions::EFFECT_TAN_DRUNK_Z],
+			fEffects[PlayerOptions::EFFECT_TAN_DRUNK_Z_SPEED], iCol,
+			fEffects[PlayerOptions::EFFECT_TAN_DRUNK_Z_OFFSET], DRUNK_Z_COLUMN_FREQUENCY,
+			fEffects[PlayerOptions::EFFECT_TAN_DRUNK_Z_PERIOD], DRUNK_Z_OFFSET_FREQUENCY,
+			DRUNK_Z_ARROW_MAGNITUDE, ArrowEffects::GetTime(), true,
+			pYOffsets, pZOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_BEAT_Z] != 0 )
 	{
-		const float fShift = data.m_fBeatFactor[dim_z]*RageFastSin( fYOffset / ((fEffects[PlayerOptions::EFFECT_BEAT_Z_PERIOD]*BEAT_Z_OFFSET_HEIGHT)+BEAT_Z_OFFSET_HEIGHT) + PI/BEAT_Z_PI_HEIGHT );
-		fZPos += fEffects[PlayerOptions::EFFECT_BEAT_Z] * fShift;
+		AddBeatOffsets(fEffects[PlayerOptions::EFFECT_BEAT_Z], data.m_fBeatFactor[dim_z],
+			fEffects[PlayerOptions::EFFECT_BEAT_Z_PERIOD], BEAT_Z_OFFSET_HEIGHT,
+			BEAT_Z_PI_HEIGHT, pYOffsets, pZOut, iCount);
 	}
 
 	if( fEffects[PlayerOptions::EFFECT_DIGITAL_Z] != 0 )
-		fZPos += (fEffects[PlayerOptions::EFFECT_DIGITAL_Z] * ARROW_SIZE * 0.5f) *
-			std::round((fEffects[PlayerOptions::EFFECT_DIGITAL_Z_STEPS]+1) * RageFastSin(
-				CalculateDigitalAngle(fYOffset,
-				fEffects[PlayerOptions::EFFECT_DIGITAL_Z_OFFSET],
-				fEffects[PlayerOptions::EFFECT_DIGITAL_Z_PERIOD]) ) ) /(fEffects[PlayerOptions::EFFECT_DIGITAL_Z_STEPS]+1);
+		AddDigitalOffsets(fEffects[PlayerOptions::EFFECT_DIGITAL_Z],
+			fEffects[PlayerOptions::EFFECT_DIGITAL_Z_STEPS],
+			fEffects[PlayerOptions::EFFECT_DIGITAL_Z_OFFSET],
+			fEffects[PlayerOptions::EFFECT_DIGITAL_Z_PERIOD], false,
+			pYOffsets, pZOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_Z] != 0 )
-		fZPos += (fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_Z] * ARROW_SIZE * 0.5f) *
-			std::round((fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_Z_STEPS]+1) * SelectTanType(
-				CalculateDigitalAngle(fYOffset,
-				fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_Z_OFFSET],
-				fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_Z_PERIOD]), curr_options->m_bCosecant ) ) /(fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_Z_STEPS]+1);
-
+		AddDigitalOffsets(fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_Z],
+			fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_Z_STEPS],
+			fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_Z_OFFSET],
+			fEffects[PlayerOptions::EFFECT_TAN_DIGITAL_Z_PERIOD], true,
+			pYOffsets, pZOut, iCount);
 
 	if( fEffects[PlayerOptions::EFFECT_SQUARE_Z] != 0 )
 	{
-		float fResult = RageSquare( (PI * (fYOffset+(1.0f*(fEffects[PlayerOptions::EFFECT_SQUARE_Z_OFFSET]))) /
-			(ARROW_SIZE+(fEffects[PlayerOptions::EFFECT_SQUARE_Z_PERIOD]*ARROW_SIZE))) );
-		fZPos += (fEffects[PlayerOptions::EFFECT_SQUARE_Z] * ARROW_SIZE * 0.5f) * fResult;
+		AddSquareOffsets(fEffects[PlayerOptions::EFFECT_SQUARE_Z],
+			fEffects[PlayerOptions::EFFECT_SQUARE_Z_OFFSET],
+			fEffects[PlayerOptions::EFFECT_SQUARE_Z_PERIOD], pYOffsets, pZOut, iCount);
 	}
 
 	if( fEffects[PlayerOptions::EFFECT_BOUNCE_Z] != 0 )
 	{
-		float fBounceAmt = std::abs( RageFastSin( ( (fYOffset + (1.0f * (fEffects[PlayerOptions::EFFECT_BOUNCE_Z_OFFSET]) ) ) /
-			( 60 + (fEffects[PlayerOptions::EFFECT_BOUNCE_Z_PERIOD]*60) ) ) ) );
-
-		fZPos += fEffects[PlayerOptions::EFFECT_BOUNCE_Z] * ARROW_SIZE * 0.5f * fBounceAmt;
+		AddBounceOffsets(fEffects[PlayerOptions::EFFECT_BOUNCE_Z],
+			fEffects[PlayerOptions::EFFECT_BOUNCE_Z_OFFSET],
+			fEffects[PlayerOptions::EFFECT_BOUNCE_Z_PERIOD], pYOffsets, pZOut, iCount);
 	}
+}
 
+float ArrowEffects::GetZPos( const PlayerState* pPlayerState, int iCol, float fYOffset)
+{
+	float fZPos;
+	CalcZPositions( pPlayerState, iCol, &fYOffset, &fZPos, 1 );
 	return fZPos;
 }
 
+void ArrowEffects::GetXYZPositions( const PlayerState* pPlayerState, int iCol, const float* pYOffsets, float fYReverseOffsetPixels, float* pXOut, float* pYOut, float* pZOut, int iCount )
+{
+	CalcXPositions( pPlayerState, iCol, pYOffsets, pXOut, iCount );
+	CalcYPositions( pPlayerState, iCol, pYOffsets, fYReverseOffsetPixels, true, pYOut, iCount );
+	CalcZPositions( pPlayerState, iCol, pYOffsets, pZOut, iCount );
+
+	const float fMoveX = GetMoveX(iCol);
+	const float fMoveY = GetMoveY(iCol);
+	const float fMoveZ = GetMoveZ(iCol);
+	for( int i = 0; i < iCount; ++i )
+	{
+		pXOut[i] = fMoveX + pXOut[i];
+		pYOut[i] = fMoveY + pYOut[i];
+		pZOut[i] = fMoveZ + pZOut[i];
+	}
+}
+
 bool ArrowEffects::NeedZBuffer()
 {
 	const float* fEffects = curr_options->m_fEffects;
@@ -1335,45 +1651,104 @@ bool ArrowEffects::NeedZBuffer()
 	return false;
 }
 
-float ArrowEffects::GetZoom( const PlayerState* pPlayerState, float fYOffset, int iCol )
+bool ArrowEffects::IsHoldShapeStatic(int iCol)
+{
+	// These only move or scale the column as a whole.  Everything else in
+	// m_fEffects is either a mod that depends on the y offset or a parameter
+	// of one, so this errs on the side of evaluating each slice.
+	const float* fEffects = curr_options->m_fEffects;
+	for( int i = 0; i < PlayerOptions::NUM_EFFECTS; ++i )
+	{
+		switch( i )
+		{
+			case PlayerOptions::EFFECT_MINI:
+			case PlayerOptions::EFFECT_TINY:
+			case PlayerOptions::EFFECT_FLIP:
+			case PlayerOptions::EFFECT_INVERT:
+				break;
+			default:
+				if( fEffects[i] != 0 )
+					return false;
+				break;
+		}
+	}
+	return curr_options->m_fBumpy[iCol] == 0;
+}
+
+static void ApplyZoomVariable( const float* pYOffsets, float* pZoom, int iCount )
+{
+	const float* fEffects = curr_options->m_fEffects;
+	if( fEffects[PlayerOptions::EFFECT_PULSE_INNER] != 0 || fEffects[PlayerOptions::EFFECT_PULSE_OUTER] != 0 )
+	{
+		const float fPulseOffset = 100.0f*(fEffects[PlayerOptions::EFFECT_PULSE_OFFSET]);
+		const float fPulseWidth = 0.4f*(ARROW_SIZE+(fEffects[PlayerOptions::EFFECT_PULSE_PERIOD]*ARROW_SIZE));
+		const float fPulseOuter = fEffects[PlayerOptions::EFFECT_PULSE_OUTER]*0.5f;
+		const float fPulseInner = ArrowEffects::GetPulseInner();
+		for( int i = 0; i < iCount; ++i )
+		{
+			float sine = RageFastSin(((pYOffsets[i]+fPulseOffset)/fPulseWidth));
+			pZoom[i] *= (sine*fPulseOuter)+fPulseInner;
+		}
+	}
+	if( fEffects[PlayerOptions::EFFECT_SHRINK_TO_MULT] !=0 )
+	{
+		const float fShrink = fEffects[PlayerOptions::EFFECT_SHRINK_TO_MULT]/100.0f;
+		for( int i = 0; i < iCount; ++i )
+		{
+			if( pYOffsets[i] >= 0 )
+				pZoom[i] *= 1/(1+(pYOffsets[i]*fShrink));
+		}
+	}
+
+	if( fEffects[PlayerOptions::EFFECT_SHRINK_TO_LINEAR] !=0 )
+	{
+		const float fShrink = 0.5f*fEffects[PlayerOptions::EFFECT_SHRINK_TO_LINEAR]/ARROW_SIZE;
+		for( int i = 0; i < iCount; ++i )
+		{
+			if( pYOffsets[i] >= 0 )
+				pZoom[i] += pYOffsets[i]*fShrink;
+		}
+	}
+}
+
+void ArrowEffects::GetZooms( const PlayerState* pPlayerState, int iCol, const float* pYOffsets, float* pZoomsOut, int iCount )
 {
-	float fZoom = 1.0f;
 	// Design change:  Instead of having a flag in the style that toggles a
 	// fixed zoom (0.6) that is only applied to the columns, ScreenGameplay now
 	// calculates a zoom factor to apply to the notefield and puts it in the
 	// PlayerState. -Kyz
-	fZoom*= pPlayerState->m_NotefieldZoom;
+	const float fFieldZoom = 1.0f * pPlayerState->m_NotefieldZoom;
+	for( int i = 0; i < iCount; ++i )
+		pZoomsOut[i] = fFieldZoom;
 
-	fZoom = GetZoomVariable( fYOffset, iCol, fZoom);
+	ApplyZoomVariable( pYOffsets, pZoomsOut, iCount );
 
 	float fTinyPercent = curr_options->m_fEffects[PlayerOptions::EFFECT_TINY];
 	if( fTinyPercent != 0 )
 	{
 		fTinyPercent = std::pow( 0.5f, fTinyPercent );
-		fZoom *= fTinyPercent;
+		for( int i = 0; i < iCount; ++i )
+			pZoomsOut[i] *= fTinyPercent;
 	}
 	if( curr_options->m_fTiny[iCol] != 0 )
 	{
 		fTinyPercent = std::pow( 0.5f, curr_options->m_fTiny[iCol] );
-		fZoom *= fTinyPercent;
+		for( int i = 0; i < iCount; ++i )
+			pZoomsOut[i] *= fTinyPercent;
 	}
+}
+
+float ArrowEffects::GetZoom( const PlayerState* pPlayerState, float fYOffset, int iCol )
+{
+	float fZoom;
+	GetZooms( pPlayerState, iCol, &fYOffset, &fZoom, 1 );
 	return fZoom;
 }
 
 float ArrowEffects::GetZoomVariable( float fYOffset, int iCol, float fCurZoom )
 {
 	float fZoom = fCurZoom;
-	if( curr_options->m_fEffects[PlayerOptions::EFFECT_PULSE_INNER] != 0 || curr_options->m_fEffects[PlayerOptions::EFFECT_PULSE_OUTER] != 0 )
-	{
-		float sine = RageFastSin(((fYOffset+(100.0f*(curr_options->m_fEffects[PlayerOptions::EFFECT_PULSE_OFFSET])))/(0.4f*(ARROW_SIZE+(curr_options->m_fEffects[PlayerOptions::EFFECT_PULSE_PERIOD]*ARROW_SIZE)))));
-
-		fZoom *= (sine*(curr_options->m_fEffects[PlayerOptions::EFFECT_PULSE_OUTER]*0.5f))+GetPulseInner();
-	}
-	if( curr_options->m_fEffects[PlayerOptions::EFFECT_SHRINK_TO_MULT] !=0 && fYOffset >= 0 )
-		fZoom *= 1/(1+(fYOffset*(curr_options->m_fEffects[PlayerOptions::EFFECT_SHRINK_TO_MULT]/100.0f)));
-
-	if( curr_options->m_fEffects[PlayerOptions::EFFECT_SHRINK_TO_LINEAR] !=0 && fYOffset >= 0 )
-		fZoom += fYOffset*(0.5f*curr_options->m_fEffects[PlayerOptions::EFFECT_SHRINK_TO_LINEAR]/ARROW_SIZE);
+	ApplyZoomVariable( &fYOffset, &fZoom, 1 );
 	return fZoom;
 }
 
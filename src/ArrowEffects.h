@@ -88,6 +88,11 @@ public:
 	// Enable this if any ZPos effects are enabled.
 	static bool NeedZBuffer();
 
+	// True if none of the current mods change a hold's position, zoom or
+	// rotation along its length, so that the values at one y offset hold for
+	// the whole hold.
+	static bool IsHoldShapeStatic(int iCol);
+
 	// fAlpha is the transparency of the arrow.  It depends on fYPos and the 
 	// AppearanceType.
 	static float GetAlpha(const PlayerState* pPlayerState, int iCol, float fYPos, float fPercentFadeToFail, float fYReverseOffsetPixels, float fDrawDistanceBeforeTargetsPixels, float fFadeInPercentOfDrawFar);
@@ -111,6 +116,19 @@ public:
 	static float GetPulseInner();
 
 	static float GetFrameWidthScale( const PlayerState* pPlayerState, float fYOffset, float fOverlappedTime );
+
+	// Batched forms of the functions above, for evaluating every visible note
+	// in a column at once.  The arrays are parallel: entry i of each output
+	// belongs to entry i of the input.  The terms that are the same for every
+	// note in the column are worked out once per call, and each effect is
+	// applied in its own loop over the batch.  The single note functions are
+	// the same code with a batch of one.
+	static void GetYOffsets( const PlayerState* pPlayerState, int iCol, const float* pNoteBeats, float* pYOffsetsOut, int iCount, bool bAbsolute=false );
+	static void GetXYZPositions( const PlayerState* pPlayerState, int iCol, const float* pYOffsets, float fYReverseOffsetPixels, float* pXOut, float* pYOut, float* pZOut, int iCount );
+	// Roll doesn't turn hold caps, and Dizzy only turns hold heads with DizzyHolds.
+	static void GetRotations( const PlayerState* pPlayerState, int iCol, const float* pNoteBeats, const float* pYOffsets, float* pRotXOut, float* pRotYOut, float* pRotZOut, int iCount, bool bIsHoldHead=false, bool bIsHoldCap=false );
+	static void GetZooms( const PlayerState* pPlayerState, int iCol, const float* pYOffsets, float* pZoomsOut, int iCount );
+	static void GetAlphasAndGlows( const PlayerState* pPlayerState, int iCol, const float* pYOffsets, const float* pPercentFadeToFail, float fYReverseOffsetPixels, float fDrawDistanceBeforeTargetsPixels, float fFadeInPercentOfDrawFar, float* pAlphasOut, float* pGlowsOut, int iCount );
 };
 
 #endif
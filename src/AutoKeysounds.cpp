@@ -47,6 +47,33 @@ void AutoKeysounds::LoadAutoplaySoundsInto( RageSoundReader_Chain *pChain )
 	Song* pSong = GAMESTATE->m_pCurSong;
 	RString sSongDir = pSong->GetSongDir();
 
+	/*
+	 * Decode every autoplay sound up front, in parallel; pChain->LoadSound will
+	 * share the preloaded data.
+	 */
+	{
+		std::vector<bool> vbUsed( pSong->m_vsKeysoundFile.size(), false );
+		FOREACH_EnabledPlayer(pn)
+		{
+			const NoteData &nd = m_ndAutoKeysoundsOnly[pn];
+			for( int t = 0; t < nd.GetNumTracks(); t++ )
+			{
+				for( NoteData::const_iterator it = nd.begin(t); it != nd.end(t); ++it )
+				{
+					const int iIndex = it->second.iKeysoundIndex;
+					if( iIndex >= 0 && iIndex < (int) vbUsed.size() )
+						vbUsed[iIndex] = true;
+				}
+			}
+		}
+
+		std::vector<RString> vsPaths;
+		for( unsigned i = 0; i < vbUsed.size(); ++i )
+			if( vbUsed[i] )
+				vsPaths.push_back( sSongDir + pSong->m_vsKeysoundFile[i] );
+		SOUNDMAN->PreloadSounds( vsPaths );
+	}
+
 	/*
 	 * Add all current autoplay sounds in both players to the chain.
 	 */
@@ -481,11 +481,15 @@ void BGAnimationLayer::LoadFromNode( const XNode* pNode )
 
 			CollapsePath( sFile );
 
+			const bool bCopy = ActorUtil::CanCopyActorFrom( sFile );
+			Actor *pFirst = nullptr;
 			for( int i=0; i<iNumParticles; i++ )
 			{
-				Actor* pActor = ActorUtil::MakeActor( sFile, this );
+				Actor* pActor = (bCopy && pFirst)? pFirst->Copy():ActorUtil::MakeActor( sFile, this );
 				if( pActor == nullptr )
 					continue;
+				if( pFirst == nullptr )
+					pFirst = pActor;
 				this->AddChild( pActor );
 				pActor->SetXY( randomf(float(FullScreenRectF.left),float(FullScreenRectF.right)),
 							   randomf(float(FullScreenRectF.top),float(FullScreenRectF.bottom)) );
@@ -519,11 +523,15 @@ void BGAnimationLayer::LoadFromNode( const XNode* pNode )
 			m_iNumTilesWide = 2+(int)(SCREEN_WIDTH /m_fTilesSpacingX);
 			m_iNumTilesHigh = 2+(int)(SCREEN_HEIGHT/m_fTilesSpacingY);
 			unsigned NumSprites = m_iNumTilesWide * m_iNumTilesHigh;
+			const bool bCopy = ActorUtil::CanCopyActorFrom( sFile );
+			Actor *pFirst = nullptr;
 			for( unsigned i=0; i<NumSprites; i++ )
 			{
-				Actor* pSprite = ActorUtil::MakeActor( sFile, this );
+				Actor* pSprite = (bCopy && pFirst)? pFirst->Copy():ActorUtil::MakeActor( sFile, this );
 				if( pSprite == nullptr )
 					continue;
+				if( pFirst == nullptr )
+					pFirst = pSprite;
 				this->AddChild( pSprite );
 				pSprite->SetTextureWrapping( true );		// gets rid of some "cracks"
 				pSprite->SetZoom( randomf(fZoomMin,fZoomMax) );
@@ -107,12 +107,14 @@ source_group("Data Structures\\\\Notes Writers"
              ${SM_DATA_NOTEWRITE_HPP})
 
 list(APPEND SM_DATA_SCORE_SRC
+            "ChartReplay.cpp"
             "ScoreKeeper.cpp"
             "ScoreKeeperNormal.cpp"
             "ScoreKeeperRave.cpp"
             "ScoreKeeperShared.cpp")
 
 list(APPEND SM_DATA_SCORE_HPP
+            "ChartReplay.h"
             "ScoreKeeper.h"
             "ScoreKeeperNormal.h"
             "ScoreKeeperRave.h"
@@ -188,6 +190,7 @@ list(APPEND SM_DATA_REST_SRC
             "HighScore.cpp"
             "Inventory.cpp"
             "JsonUtil.cpp"
+            "LifeRecord.cpp"
             "LocalizedString.cpp"
             "LyricsLoader.cpp"
             "ModsGroup.cpp"
@@ -240,6 +243,7 @@ list(APPEND SM_DATA_REST_HPP
             "InputEventPlus.h"
             "Inventory.h"
             "JsonUtil.h"
+            "LifeRecord.h"
             "LocalizedString.h"
             "LyricsLoader.h"
             "ModsGroup.h"
@@ -156,6 +156,7 @@ list(APPEND SMDATA_RAGE_SOUND_SRC
             "RageSoundManager.cpp"
             "RageSoundMixBuffer.cpp"
             "RageSoundPosMap.cpp"
+            "RageSoundPreviewCache.cpp"
             "RageSoundReader.cpp"
             "RageSoundReader_Chain.cpp"
             "RageSoundReader_ChannelSplit.cpp"
@@ -179,6 +180,7 @@ list(APPEND SMDATA_RAGE_SOUND_HPP
             "RageSoundManager.h"
             "RageSoundMixBuffer.h"
             "RageSoundPosMap.h"
+            "RageSoundPreviewCache.h"
             "RageSoundReader.h"
             "RageSoundReader_Chain.h"
             "RageSoundReader_ChannelSplit.h"
@@ -0,0 +1,307 @@
+#include "global.h"
+#include "ChartReplay.h"
+#include "GameManager.h"
+#include "GameState.h"
+#include "LuaManager.h"
+#include "NoteData.h"
+#include "Player.h"
+#include "PlayerStageStats.h"
+#include "PlayerState.h"
+#include "PrefsManager.h"
+#include "RageFile.h"
+#include "RageLog.h"
+#include "RageTimer.h"
+#include "RageUtil.h"
+#include "ScoreKeeperNormal.h"
+#include "Song.h"
+#include "SongManager.h"
+#include "SongUtil.h"
+#include "Steps.h"
+#include "TimingData.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstddef>
+#include <vector>
+
+/* How far the song clock advances between logic updates.  This matches the
+ * finest GameplayLogicHz anyone is likely to use in gameplay. */
+static const float REPLAY_STEP_SECONDS = 0.001f;
+/* Where the replay's timers start.  Any fixed nonzero time works. */
+static const int REPLAY_EPOCH_SECONDS = 1000;
+
+static bool CompareInputs( const ChartReplay::Input &a, const ChartReplay::Input &b )
+{
+	return a.m_fSeconds < b.m_fSeconds;
+}
+
+bool ChartReplay::Load( const RString &sPath, Replay &out, RString &sErrorOut )
+{
+	RageFile f;
+	if( !f.Open(sPath) )
+	{
+		sErrorOut = ssprintf( "Couldn't open %s: %s", sPath.c_str(), f.GetError().c_str() );
+		return false;
+	}
+
+	out = Replay();
+	RString sLine;
+	int iLine = 0;
+	while( f.GetLine(sLine) > 0 )
+	{
+		++iLine;
+		Trim( sLine );
+		if( sLine.empty() || sLine[0] == '#' )
+			continue;
+
+		std::vector<RString> asParts;
+		split( sLine, " ", asParts, true );
+		if( asParts.size() == 2 && asParts[0].EqualsNoCase("song") )
+			out.m_sSongDir = asParts[1];
+		else if( asParts.size() == 2 && asParts[0].EqualsNoCase("stepstype") )
+			out.m_sStepsType = asParts[1];
+		else if( asParts.size() == 2 && asParts[0].EqualsNoCase("difficulty") )
+			out.m_sDifficulty = asParts[1];
+		else if( asParts.size() == 3 && (asParts[2].EqualsNoCase("down") || asParts[2].EqualsNoCase("up")) )
+		{
+			Input in;
+			if( !StringToFloat(asParts[0], in.m_fSeconds) )
+			{
+				sErrorOut = ssprintf( "%s:%i: bad time \"%s\"", sPath.c_str(), iLine, asParts[0].c_str() );
+				return false;
+			}
+			in.m_iColumn = StringToInt( asParts[1], nullptr, 10, -1 );
+			in.m_bRelease = asParts[2].EqualsNoCase("up");
+			out.m_vInputs.push_back( in );
+		}
+		else
+		{
+			sErrorOut = ssprintf( "%s:%i: couldn't parse \"%s\"", sPath.c_str(), iLine, sLine.c_str() );
+			return false;
+		}
+	}
+
+	std::stable_sort( out.m_vInputs.begin(), out.m_vInputs.end(), CompareInputs );
+	return true;
+}
+
+bool ChartReplay::Run( PlayerNumber pn, const Replay &replay, PlayerStageStats &pssOut, RString &sErrorOut )
+{
+	Song *pSong = GAMESTATE->m_pCurSong;
+	Steps *pSteps = GAMESTATE->m_pCurSteps[pn];
+	if( pSong == nullptr || pSteps == nullptr )
+	{
+		sErrorOut = "No song and steps are selected";
+		return false;
+	}
+	const TimingData *pTiming = pSteps->GetTimingData();
+
+	PlayerState ps;
+	ps.SetPlayerNumber( pn );
+	ps.m_PlayerOptions = GAMESTATE->m_pPlayerState[pn]->m_PlayerOptions;
+	ps.m_PlayerController = PC_HUMAN;
+
+	pssOut = PlayerStageStats();
+	pssOut.Init( pn );
+
+	NoteData nd;
+	pSteps->GetNoteData( nd );
+	if( nd.GetLastRow() < 0 )
+	{
+		sErrorOut = "The steps have no notes";
+		return false;
+	}
+
+	// Start far enough ahead of the first note or input that nothing is
+	// missed before we begin, and run until the last note can't be hit.
+	float fStartSeconds = pTiming->GetElapsedTimeFromBeat( nd.GetFirstBeat() );
+	float fEndSeconds = pTiming->GetElapsedTimeFromBeat( nd.GetLastBeat() );
+	if( !replay.m_vInputs.empty() )
+	{
+		fStartSeconds = std::min( fStartSeconds, replay.m_vInputs.front().m_fSeconds );
+		fEndSeconds = std::max( fEndSeconds, replay.m_vInputs.back().m_fSeconds );
+	}
+	const float fRate = GAMESTATE->m_SongOptions.GetCurrent().m_fMusicRate;
+	const float fMargin = Player::GetMaxStepDistanceSeconds() * fRate + 1.0f;
+	fStartSeconds -= fMargin;
+	fEndSeconds += fMargin;
+	ps.m_Position.UpdateSongPosition( fStartSeconds, *pTiming );
+
+	std::vector<Song*> vpSongs( 1, pSong );
+	std::vector<Steps*> vpSteps( 1, pSteps );
+	std::vector<AttackArray> vAttacks( 1 );
+	ScoreKeeperNormal keeper( &ps, &pssOut );
+	keeper.SetSendMessages( false );
+	keeper.Load( vpSongs, vpSteps, vAttacks );
+
+	Player player( nd, false );
+	player.SetSendJudgmentAndComboMessages( false );
+	player.Init( "Player", &ps, &pssOut, nullptr, nullptr, nullptr, nullptr, nullptr, &keeper, nullptr );
+	player.Load();
+	keeper.OnNextSong( 0, pSteps, &player.GetNoteData() );
+
+	std::vector<float> vPressedSeconds( player.GetNoteData().GetNumTracks(), -FLT_MAX );
+	player.SetReplayHeldState( &vPressedSeconds );
+
+	// Player measures step offsets against timers.  Build every timer from
+	// a fixed epoch and the recorded song seconds, never the real clock, so
+	// a replay always scores the same.
+	const RageTimer tmEpoch( REPLAY_EPOCH_SECONDS, 0 );
+	const float fTweenRate = PREFSMAN->m_bRateModsAffectTweens ? fRate : 1.0f;
+	const float fDeltaTime = REPLAY_STEP_SECONDS / fRate * fTweenRate;
+	const int iNumTicks = int( (fEndSeconds - fStartSeconds) / REPLAY_STEP_SECONDS ) + 1;
+	std::size_t iNextInput = 0;
+	for( int i = 0; i <= iNumTicks; ++i )
+	{
+		const float fSeconds = fStartSeconds + i * REPLAY_STEP_SECONDS;
+		const RageTimer now = tmEpoch + (fSeconds - fStartSeconds) / fRate;
+		ps.m_Position.UpdateSongPosition( fSeconds, *pTiming, now );
+		player.SetReplayNow( now );
+		player.UpdateLogicSubstep( fDeltaTime, now );
+
+		for( ; iNextInput < replay.m_vInputs.size() && replay.m_vInputs[iNextInput].m_fSeconds <= fSeconds; ++iNextInput )
+		{
+			const Input &in = replay.m_vInputs[iNextInput];
+			if( in.m_iColumn < 0 || in.m_iColumn >= int(vPressedSeconds.size()) )
+				continue;
+			vPressedSeconds[in.m_iColumn] = in.m_bRelease ? -FLT_MAX : in.m_fSeconds;
+			const RageTimer tmInput = tmEpoch + (in.m_fSeconds - fStartSeconds) / fRate;
+			player.Step( in.m_iColumn, -1, tmInput, false, in.m_bRelease );
+		}
+	}
+
+	player.SetReplayHeldState( nullptr );
+	return true;
+}
+
+static void LogResults( const RString &sPath, const PlayerStageStats &pss )
+{
+	RString sCounts;
+	FOREACH_ENUM( TapNoteScore, tns )
+	{
+		if( pss.m_iTapNoteScores[tns] != 0 )
+			sCounts += ssprintf( " %s=%i", TapNoteScoreToString(tns).c_str(), pss.m_iTapNoteScores[tns] );
+	}
+	FOREACH_ENUM( HoldNoteScore, hns )
+	{
+		if( pss.m_iHoldNoteScores[hns] != 0 )
+			sCounts += ssprintf( " %s=%i", HoldNoteScoreToString(hns).c_str(), pss.m_iHoldNoteScores[hns] );
+	}
+	LOG->Info( "Replay %s: %.4f%% (%i/%i dance points), score %i,%s",
+		sPath.c_str(), pss.GetPercentDancePoints() * 100, pss.m_iActualDancePoints,
+		pss.m_iPossibleDancePoints, pss.m_iScore, sCounts.c_str() );
+}
+
+bool ChartReplay::HandleCommandLine()
+{
+	RString sPath;
+	int iIndex = 0;
+	for( ; GetCommandlineArgument("replay", &sPath, iIndex); ++iIndex )
+	{
+		Replay replay;
+		RString sError;
+		if( !Load(sPath, replay, sError) )
+		{
+			LOG->Warn( "%s", sError.c_str() );
+			continue;
+		}
+
+		Song *pSong = SONGMAN->GetSongFromDir( replay.m_sSongDir );
+		const StepsType st = GAMEMAN->StringToStepsType( replay.m_sStepsType );
+		const Difficulty dc = StringToDifficulty( replay.m_sDifficulty );
+		Steps *pSteps = pSong ? SongUtil::GetStepsByDifficulty( pSong, st, dc ) : nullptr;
+		if( pSteps == nullptr )
+		{
+			LOG->Warn( "Replay %s: couldn't find %s %s steps for \"%s\"", sPath.c_str(),
+				replay.m_sStepsType.c_str(), replay.m_sDifficulty.c_str(), replay.m_sSongDir.c_str() );
+			continue;
+		}
+
+		GAMESTATE->Reset();
+		GAMESTATE->m_bSideIsJoined[PLAYER_1] = true;
+		GAMESTATE->SetMasterPlayerNumber( PLAYER_1 );
+		GAMESTATE->SetCurrentStyle( GAMEMAN->GetEditorStyleForStepsType(st), PLAYER_1 );
+		GAMESTATE->m_pCurSong.Set( pSong );
+		GAMESTATE->m_pCurSteps[PLAYER_1].Set( pSteps );
+
+		PlayerStageStats pss;
+		if( Run(PLAYER_1, replay, pss, sError) )
+			LogResults( sPath, pss );
+		else
+			LOG->Warn( "Replay %s: %s", sPath.c_str(), sError.c_str() );
+	}
+	return iIndex > 0;
+}
+
+// lua start
+/* ReplayChart(path, pn): score a replay file against the current song and
+ * steps for pn.  Returns a table of results, or nil and an error message. */
+int LuaFunc_ReplayChart( lua_State *L );
+int LuaFunc_ReplayChart( lua_State *L )
+{
+	const RString sPath = SArg(1);
+	const PlayerNumber pn = Enum::Check<PlayerNumber>( L, 2 );
+
+	ChartReplay::Replay replay;
+	PlayerStageStats pss;
+	RString sError;
+	if( !ChartReplay::Load(sPath, replay, sError) || !ChartReplay::Run(pn, replay, pss, sError) )
+	{
+		lua_pushnil( L );
+		LuaHelpers::Push( L, sError );
+		return 2;
+	}
+
+	lua_newtable( L );
+	LuaHelpers::Push( L, pss.GetPercentDancePoints() );
+	lua_setfield( L, -2, "PercentDancePoints" );
+	LuaHelpers::Push( L, pss.m_iActualDancePoints );
+	lua_setfield( L, -2, "ActualDancePoints" );
+	LuaHelpers::Push( L, pss.m_iPossibleDancePoints );
+	lua_setfield( L, -2, "PossibleDancePoints" );
+	LuaHelpers::Push( L, pss.m_iScore );
+	lua_setfield( L, -2, "Score" );
+
+	lua_newtable( L );
+	FOREACH_ENUM( TapNoteScore, tns )
+	{
+		LuaHelpers::Push( L, pss.m_iTapNoteScores[tns] );
+		lua_setfield( L, -2, TapNoteScoreToString(tns).c_str() );
+	}
+	lua_setfield( L, -2, "TapNoteScores" );
+
+	lua_newtable( L );
+	FOREACH_ENUM( HoldNoteScore, hns )
+	{
+		LuaHelpers::Push( L, pss.m_iHoldNoteScores[hns] );
+		lua_setfield( L, -2, HoldNoteScoreToString(hns).c_str() );
+	}
+	lua_setfield( L, -2, "HoldNoteScores" );
+	return 1;
+}
+LUAFUNC_REGISTER_COMMON( ReplayChart );
+
+/*
+ * (c) 2026 ITGmania team
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, and/or sell copies of the Software, and to permit persons to
+ * whom the Software is furnished to do so, provided that the above
+ * copyright notice(s) and this permission notice appear in all copies of
+ * the Software and that both the above copyright notice(s) and this
+ * permission notice appear in supporting documentation.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF
+ * THIRD PARTY RIGHTS. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR HOLDERS
+ * INCLUDED IN THIS NOTICE BE LIABLE FOR ANY CLAIM, OR ANY SPECIAL INDIRECT
+ * OR CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
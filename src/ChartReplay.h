@@ -0,0 +1,81 @@
+/* ChartReplay - Re-score a recorded input stream without playing the song. */
+
+#ifndef CHART_REPLAY_H
+#define CHART_REPLAY_H
+
+#include "PlayerNumber.h"
+
+#include <vector>
+
+class PlayerStageStats;
+
+/* A replay file is plain text, one entry per line:
+ *
+ *   song /Songs/Group/Title/
+ *   stepstype dance-single
+ *   difficulty Challenge
+ *   12.3456 0 down
+ *   12.5012 0 up
+ *
+ * Input lines are the song time in seconds, the column, and "down" or "up".
+ * Lines starting with # are ignored.  The song, stepstype and difficulty are
+ * only needed when the replay is run from the command line.
+ *
+ * The inputs are fed through Player and ScoreKeeperNormal exactly as in
+ * gameplay, without rendering or audio, stepping the song clock forward in
+ * fixed increments. */
+namespace ChartReplay
+{
+	struct Input
+	{
+		float m_fSeconds;
+		int m_iColumn;
+		bool m_bRelease;
+	};
+
+	struct Replay
+	{
+		RString m_sSongDir;
+		RString m_sStepsType;
+		RString m_sDifficulty;
+		std::vector<Input> m_vInputs;
+	};
+
+	bool Load( const RString &sPath, Replay &out, RString &sErrorOut );
+
+	/* Score the replay against the song and steps GAMESTATE has selected for
+	 * pn, with that player's current modifiers.  pssOut is reset first. */
+	bool Run( PlayerNumber pn, const Replay &replay, PlayerStageStats &pssOut, RString &sErrorOut );
+
+	/* Score each --replay=<file> given on the command line and log the
+	 * results.  This sets up GAMESTATE for the replay, so it's only run at
+	 * startup.  Returns true if there were any, and the game should exit. */
+	bool HandleCommandLine();
+}
+
+#endif
+
+/*
+ * (c) 2026 ITGmania team
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, and/or sell copies of the Software, and to permit persons to
+ * whom the Software is furnished to do so, provided that the above
+ * copyright notice(s) and this permission notice appear in all copies of
+ * the Software and that both the above copyright notice(s) and this
+ * permission notice appear in supporting documentation.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF
+ * THIRD PARTY RIGHTS. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR HOLDERS
+ * INCLUDED IN THIS NOTICE BE LIABLE FOR ANY CLAIM, OR ANY SPECIAL INDIRECT
+ * OR CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
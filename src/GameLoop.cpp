@@ -14,12 +14,14 @@
 #include "GameState.h"
 #include "MemoryCardManager.h"
 #include "ScreenManager.h"
+#include "Screen.h"
 #include "InputFilter.h"
 #include "InputMapper.h"
 #include "RageFileManager.h"
 #include "LightsManager.h"
 #include "RageTimer.h"
 #include "RageInput.h"
+#include "LuaManager.h"
 
 #include <cmath>
 #include <vector>
@@ -327,6 +329,9 @@ void GameLoop::RunGameLoop()
 		CheckInputDevicesCounter++;
 		
 		SCREENMAN->Draw();
+
+		const Screen *pScreen = SCREENMAN->GetTopScreen();
+		LUA->StepGarbageCollector( pScreen != nullptr && pScreen->GetScreenType() == gameplay );
 	}
 
 	// If we ended mid-game, finish up.
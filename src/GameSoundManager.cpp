@@ -17,6 +17,7 @@
 #include "LightsManager.h"
 #include "SongUtil.h"
 #include "LuaManager.h"
+#include "RageSoundPreviewCache.h"
 
 #include "arch/Sound/RageSoundDriver.h"
 
@@ -83,6 +84,9 @@ struct MusicPlaying
 
 static MusicPlaying *g_Playing;
 
+/* Decoded sample music segments; see RageSoundPreviewCache. */
+static RageSoundPreviewCache *g_pPreviewCache = nullptr;
+
 static RageThread MusicThread;
 
 std::vector<RString> g_SoundsToPlayOnce;
@@ -137,7 +141,13 @@ static void StartMusic( MusicToPlay &ToPlay )
 		RageSound *pSound = new RageSound;
 		RageSoundLoadParams params;
 		params.m_bSupportRateChanging = ToPlay.bApplyMusicRate;
-		pSound->Load( ToPlay.m_sFile, false, &params );
+
+		/* If the sample was decoded ahead of time, we don't need to seek. */
+		RageSoundReader *pCached = g_pPreviewCache->GetCachedPreview( ToPlay.m_sFile, ToPlay.fStartSecond, ToPlay.fLengthSeconds );
+		if( pCached != nullptr )
+			pSound->LoadDecoded( ToPlay.m_sFile, pCached, &params );
+		else
+			pSound->Load( ToPlay.m_sFile, false, &params );
 		g_Mutex->Lock();
 
 		NewMusic = new MusicPlaying( pSound );
@@ -445,6 +455,7 @@ GameSoundManager::GameSoundManager()
 
 	g_Mutex = new RageEvent("GameSoundManager");
 	g_Playing = new MusicPlaying( new RageSound );
+	g_pPreviewCache = new RageSoundPreviewCache;
 
 	g_UpdatingTimer = true;
 
@@ -477,6 +488,7 @@ GameSoundManager::~GameSoundManager()
 	LOG->Trace("Music start thread shut down.");
 
 	SAFE_DELETE( g_Playing );
+	SAFE_DELETE( g_pPreviewCache );
 	SAFE_DELETE( g_Mutex );
 }
 
@@ -768,6 +780,19 @@ void GameSoundManager::PlayMusic( PlayMusicParams params, PlayMusicParams Fallba
 	g_Mutex->Unlock();
 }
 
+void GameSoundManager::PrefetchMusicPreview( const RString &sFile, float fStartSecond, float fLengthSeconds )
+{
+	/* Only sample ranges are cached; full-length music is streamed as usual. */
+	if( fLengthSeconds < 0 )
+		return;
+	g_pPreviewCache->Prefetch( sFile, fStartSecond, fLengthSeconds );
+}
+
+void GameSoundManager::ClearMusicPreviewPrefetches()
+{
+	g_pPreviewCache->ClearPrefetches();
+}
+
 void GameSoundManager::DimMusic( float fVolume, float fDurationSeconds )
 {
 	LockMut( *g_Mutex );
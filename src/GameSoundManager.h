@@ -57,6 +57,11 @@ public:
 	RString GetMusicPath() const;
 	void Flush();
 
+	/* Decode a music sample in the background, so a later PlayMusic() of the
+	 * same range starts without seeking into the file. */
+	void PrefetchMusicPreview( const RString &sFile, float fStartSecond, float fLengthSeconds );
+	void ClearMusicPreviewPrefetches();
+
 	void PlayOnce( RString sPath );
 	void PlayOnceFromDir( RString sDir );
 	void PlayOnceFromAnnouncer( RString sFolderName );
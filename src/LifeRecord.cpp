@@ -0,0 +1,178 @@
+#include "global.h"
+#include "LifeRecord.h"
+#include "RageUtil.h"
+
+#include <algorithm>
+
+static bool CompareSecond( float fSecond, const LifeRecord::Sample &s ) { return fSecond < s.m_fSecond; }
+static bool CompareSample( const LifeRecord::Sample &s, float fSecond ) { return s.m_fSecond < fSecond; }
+
+std::vector<LifeRecord::Sample>::iterator LifeRecord::Find( float fSecond )
+{
+	// Nearly every lookup is for the newest sample.
+	if( !m_vSamples.empty() && m_vSamples.back().m_fSecond <= fSecond )
+		return m_vSamples.back().m_fSecond == fSecond ? m_vSamples.end()-1 : m_vSamples.end();
+
+	std::vector<Sample>::iterator it = std::lower_bound( m_vSamples.begin(), m_vSamples.end(), fSecond, CompareSample );
+	if( it != m_vSamples.end() && it->m_fSecond != fSecond )
+		return m_vSamples.end();
+	return it;
+}
+
+std::vector<LifeRecord::Sample>::const_iterator LifeRecord::UpperBound( float fSecond ) const
+{
+	return std::upper_bound( m_vSamples.begin(), m_vSamples.end(), fSecond, CompareSecond );
+}
+
+static void InsertOrAssign( std::vector<LifeRecord::Sample> &vSamples, float fSecond, float fLife )
+{
+	if( vSamples.empty() || vSamples.back().m_fSecond < fSecond )
+	{
+		LifeRecord::Sample s = { fSecond, fLife };
+		vSamples.push_back( s );
+		return;
+	}
+
+	std::vector<LifeRecord::Sample>::iterator it = std::lower_bound( vSamples.begin(), vSamples.end(), fSecond, CompareSample );
+	if( it != vSamples.end() && it->m_fSecond == fSecond )
+	{
+		it->m_fLife = fLife;
+		return;
+	}
+	LifeRecord::Sample s = { fSecond, fLife };
+	vSamples.insert( it, s );
+}
+
+void LifeRecord::Set( float fSecond, float fLife )
+{
+	// fSecond will usually be greater than any time already recorded, but if a
+	// tap and a hold both set the life on the same frame, it won't.  Move the
+	// old value back a tiny bit if it differs, so the graph shows a step
+	// instead of a gradual decline up to the change.
+	std::vector<Sample>::iterator curr = Find( fSecond );
+	if( curr != m_vSamples.end() && curr->m_fLife != fLife )
+	{
+		// 2^-8
+		const float fOldLife = curr->m_fLife;
+		curr->m_fLife = fLife;
+		InsertOrAssign( m_vSamples, fSecond - 0.00390625f, fOldLife );
+	}
+	else
+	{
+		InsertOrAssign( m_vSamples, fSecond, fLife );
+	}
+
+	RemoveRedundantTail();
+
+	if( m_vSamples.size() > MAX_SAMPLES )
+		Downsample();
+}
+
+void LifeRecord::Append( const LifeRecord &other, float fOffsetSeconds )
+{
+	m_vSamples.reserve( m_vSamples.size() + other.m_vSamples.size() );
+	for( const Sample &s : other.m_vSamples )
+		InsertOrAssign( m_vSamples, s.m_fSecond + fOffsetSeconds, s.m_fLife );
+
+	while( m_vSamples.size() > MAX_SAMPLES )
+		Downsample();
+}
+
+/* If the last three samples all have the same life, the middle one adds
+ * nothing.  Only the end needs checking, since that's where samples are
+ * added and everything before it has already been checked. */
+void LifeRecord::RemoveRedundantTail()
+{
+	const std::size_t iSize = m_vSamples.size();
+	if( iSize < 3 )
+		return;
+	const Sample &a = m_vSamples[iSize-3];
+	const Sample &b = m_vSamples[iSize-2];
+	const Sample &c = m_vSamples[iSize-1];
+	if( a.m_fLife == b.m_fLife && b.m_fLife == c.m_fLife )
+		m_vSamples.erase( m_vSamples.end()-2 );
+}
+
+void LifeRecord::Downsample()
+{
+	const std::size_t GROUP_SIZE = 4;
+	std::vector<Sample> vOut;
+	vOut.reserve( m_vSamples.size() / 2 + 2 );
+
+	// Keep the last sample exactly; it's the current life.
+	const std::size_t iEnd = m_vSamples.size() - 1;
+	for( std::size_t i = 0; i < iEnd; i += GROUP_SIZE )
+	{
+		const std::size_t iGroupEnd = std::min( i + GROUP_SIZE, iEnd );
+		std::size_t iMin = i, iMax = i;
+		for( std::size_t j = i+1; j < iGroupEnd; ++j )
+		{
+			if( m_vSamples[j].m_fLife < m_vSamples[iMin].m_fLife )
+				iMin = j;
+			if( m_vSamples[j].m_fLife > m_vSamples[iMax].m_fLife )
+				iMax = j;
+		}
+		vOut.push_back( m_vSamples[std::min(iMin, iMax)] );
+		if( iMin != iMax )
+			vOut.push_back( m_vSamples[std::max(iMin, iMax)] );
+	}
+	vOut.push_back( m_vSamples.back() );
+	m_vSamples.swap( vOut );
+}
+
+float LifeRecord::GetAt( float fSecond ) const
+{
+	if( m_vSamples.empty() )
+		return 0;
+
+	// Find the last sample at or before fSecond.
+	std::vector<Sample>::const_iterator it = UpperBound( fSecond );
+	if( it != m_vSamples.begin() )
+		--it;
+	return it->m_fLife;
+}
+
+float LifeRecord::GetLerpAt( float fSecond ) const
+{
+	if( m_vSamples.empty() )
+		return 0;
+
+	std::vector<Sample>::const_iterator later = UpperBound( fSecond );
+	std::vector<Sample>::const_iterator earlier = later;
+	if( earlier != m_vSamples.begin() )
+		--earlier;
+
+	if( later == m_vSamples.end() )
+		return earlier->m_fLife;
+
+	if( earlier->m_fSecond == later->m_fSecond ) // two samples from the same time.  Don't divide by zero in SCALE
+		return earlier->m_fLife;
+
+	// earlier <= pos <= later
+	return SCALE( fSecond, earlier->m_fSecond, later->m_fSecond, earlier->m_fLife, later->m_fLife );
+}
+
+/*
+ * (c) 2026 ITGmania team
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, and/or sell copies of the Software, and to permit persons to
+ * whom the Software is furnished to do so, provided that the above
+ * copyright notice(s) and this permission notice appear in all copies of
+ * the Software and that both the above copyright notice(s) and this
+ * permission notice appear in supporting documentation.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF
+ * THIRD PARTY RIGHTS. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR HOLDERS
+ * INCLUDED IN THIS NOTICE BE LIABLE FOR ANY CLAIM, OR ANY SPECIAL INDIRECT
+ * OR CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
@@ -0,0 +1,74 @@
+/* LifeRecord - Life meter value over the course of a stage. */
+
+#ifndef LIFE_RECORD_H
+#define LIFE_RECORD_H
+
+#include <cstddef>
+#include <vector>
+
+/* Samples are kept sorted by time in one vector.  Gameplay almost always
+ * appends, which is amortized constant time, and lookups are a binary search.
+ * Once the record reaches MAX_SAMPLES, it's downsampled to half that by
+ * keeping only the lowest and highest sample of each group of four, so the
+ * graph keeps its shape through long courses without growing without bound. */
+class LifeRecord
+{
+public:
+	struct Sample
+	{
+		float m_fSecond;
+		float m_fLife;
+	};
+
+	static const std::size_t MAX_SAMPLES = 16384;
+
+	void Set( float fSecond, float fLife );
+	/* Add all of other's samples, offset by fOffsetSeconds. */
+	void Append( const LifeRecord &other, float fOffsetSeconds );
+	void Clear() { m_vSamples.clear(); }
+
+	bool IsEmpty() const { return m_vSamples.empty(); }
+	std::size_t GetNumSamples() const { return m_vSamples.size(); }
+	const std::vector<Sample> &GetSamples() const { return m_vSamples; }
+
+	/* The value of the last sample at or before fSecond. */
+	float GetAt( float fSecond ) const;
+	/* Interpolated between the samples around fSecond. */
+	float GetLerpAt( float fSecond ) const;
+	float GetLast() const { return m_vSamples.empty() ? 0 : m_vSamples.back().m_fLife; }
+
+private:
+	std::vector<Sample>::iterator Find( float fSecond );
+	std::vector<Sample>::const_iterator UpperBound( float fSecond ) const;
+	void RemoveRedundantTail();
+	void Downsample();
+
+	std::vector<Sample> m_vSamples;
+};
+
+#endif
+
+/*
+ * (c) 2026 ITGmania team
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, and/or sell copies of the Software, and to permit persons to
+ * whom the Software is furnished to do so, provided that the above
+ * copyright notice(s) and this permission notice appear in all copies of
+ * the Software and that both the above copyright notice(s) and this
+ * permission notice appear in supporting documentation.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF
+ * THIRD PARTY RIGHTS. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR HOLDERS
+ * INCLUDED IN THIS NOTICE BE LIABLE FOR ANY CLAIM, OR ANY SPECIAL INDIRECT
+ * OR CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
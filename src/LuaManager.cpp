@@ -4,6 +4,7 @@
 #include "RageUtil.h"
 #include "RageLog.h"
 #include "RageFile.h"
+#include "RageFileManager.h"
 #include "RageThreads.h"
 #include "arch/Dialog/Dialog.h"
 #include "XmlFile.h"
@@ -11,6 +12,8 @@
 #include "RageLog.h"
 #include "RageTypes.h"
 #include "MessageManager.h"
+#include "Preference.h"
+#include "RageTimer.h"
 #include "ver.h"
 
 #include <cassert>
@@ -25,14 +28,23 @@
 LuaManager *LUA = nullptr;
 struct Impl
 {
-	Impl(): g_pLock("Lua") {}
+	Impl(): g_pLock("Lua"), m_bEngineDrivenGC(false), m_iGCBaselineKB(0),
+		m_iGCCycles(0), m_fLastGCStepSeconds(0) {}
 	std::vector<lua_State *> g_FreeStateList;
 	std::map<lua_State *, bool> g_ActiveStates;
 
 	RageMutex g_pLock;
+
+	bool m_bEngineDrivenGC;
+	// Memory in use when the last collection cycle finished.
+	int m_iGCBaselineKB;
+	int m_iGCCycles;
+	float m_fLastGCStepSeconds;
 };
 static Impl *pImpl = nullptr;
 
+static Preference<float> g_fLuaGCBudgetMilliseconds( "LuaGCBudgetMilliseconds", 0 );
+
 #if defined(_MSC_VER)
 	/* "interaction between '_setjmp' and C++ object destruction is non-portable"
 	 * We don't care; we'll throw a fatal exception immediately anyway. */
@@ -80,6 +92,64 @@ void LuaManager::UnsetGlobal( const RString &sName )
 	Release( L );
 }
 
+void LuaManager::StepGarbageCollector( bool bInGameplay )
+{
+	Lua *L = Get();
+
+	const float fBudgetSeconds = g_fLuaGCBudgetMilliseconds / 1000.0f;
+	if( fBudgetSeconds <= 0 )
+	{
+		if( pImpl->m_bEngineDrivenGC )
+		{
+			lua_gc( L, LUA_GCRESTART, 0 );
+			pImpl->m_bEngineDrivenGC = false;
+		}
+		Release( L );
+		return;
+	}
+	pImpl->m_bEngineDrivenGC = true;
+
+	const int iKB = lua_gc( L, LUA_GCCOUNT, 0 );
+	if( pImpl->m_iGCBaselineKB == 0 )
+		pImpl->m_iGCBaselineKB = iKB;
+
+	/* If the budget isn't keeping up with allocation, finish the cycle now
+	 * rather than let memory grow without bound.  Allow more growth during
+	 * gameplay, where finishing a cycle would show up as a skip. */
+	const int iLimitKB = pImpl->m_iGCBaselineKB * (bInGameplay? 4:2);
+	const bool bOverLimit = iKB > iLimitKB;
+
+	RageTimer start;
+	for(;;)
+	{
+		if( lua_gc(L, LUA_GCSTEP, 0) )
+		{
+			++pImpl->m_iGCCycles;
+			pImpl->m_iGCBaselineKB = std::max( lua_gc(L, LUA_GCCOUNT, 0), 1 );
+			break;
+		}
+		if( !bOverLimit && start.Ago() >= fBudgetSeconds )
+			break;
+	}
+	pImpl->m_fLastGCStepSeconds = start.Ago();
+
+	// Stepping re-arms the automatic collector, so stop it again.
+	lua_gc( L, LUA_GCSTOP, 0 );
+	Release( L );
+}
+
+RString LuaManager::GetGarbageCollectorStats()
+{
+	Lua *L = Get();
+	const int iKB = lua_gc( L, LUA_GCCOUNT, 0 );
+	Release( L );
+
+	if( !pImpl->m_bEngineDrivenGC )
+		return ssprintf( "Lua %i KB", iKB );
+	return ssprintf( "Lua %i KB\nLua GC %.2f ms, %i cycles",
+		iKB, pImpl->m_fLastGCStepSeconds * 1000, pImpl->m_iGCCycles );
+}
+
 /** @brief Utilities for working with Lua. */
 namespace LuaHelpers
 {
@@ -761,16 +831,14 @@ XNode *LuaHelpers::GetLuaInformation()
 
 bool LuaHelpers::RunScriptFile( const RString &sFile )
 {
-	RString sScript;
-	if( !GetFileContents(sFile, sScript) )
-		return false;
-
 	Lua *L = LUA->Get();
 
 	RString sError;
-	if( !LuaHelpers::RunScript( L, sScript, "@" + sFile, sError, 0 ) )
+	if( !LuaHelpers::LoadScriptFile(L, sFile, sError) || !LuaHelpers::RunScriptOnStack(L, sError) )
 	{
 		LUA->Release( L );
+		if( sError.empty() )
+			return false;
 		sError = ssprintf( "Lua runtime error: %s", sError.c_str() );
 		LuaHelpers::ReportScriptError(sError);
 		return false;
@@ -780,6 +848,59 @@ bool LuaHelpers::RunScriptFile( const RString &sFile )
 	return true;
 }
 
+namespace
+{
+	struct CompiledScript
+	{
+		int m_iFileHash;
+		RString m_sBytecode;
+	};
+	// Protected by the Lua lock.
+	std::map<RString, CompiledScript> g_CompiledScripts;
+	int g_iScriptCacheHits = 0;
+	int g_iScriptCacheMisses = 0;
+
+	int WriteBytecode( lua_State *L, const void *p, std::size_t iSize, void *pData )
+	{
+		static_cast<RString *>(pData)->append( static_cast<const char *>(p), iSize );
+		return 0;
+	}
+}
+
+bool LuaHelpers::LoadScriptFile( Lua *L, const RString &sFile, RString &sError )
+{
+	const RString sName = "@" + sFile;
+	const int iFileHash = FILEMAN->GetFileHash( sFile );
+	std::map<RString, CompiledScript>::const_iterator it = g_CompiledScripts.find( sFile );
+	if( iFileHash != -1 && it != g_CompiledScripts.end() && it->second.m_iFileHash == iFileHash )
+	{
+		++g_iScriptCacheHits;
+		return LoadScript( L, it->second.m_sBytecode, sName, sError );
+	}
+
+	++g_iScriptCacheMisses;
+	RString sScript;
+	if( !GetFileContents(sFile, sScript) )
+		return false;
+	if( !LoadScript(L, sScript, sName, sError) )
+		return false;
+
+	if( iFileHash != -1 )
+	{
+		CompiledScript &script = g_CompiledScripts[sFile];
+		script.m_iFileHash = iFileHash;
+		script.m_sBytecode = RString();
+		lua_dump( L, WriteBytecode, &script.m_sBytecode );
+	}
+	return true;
+}
+
+void LuaHelpers::GetScriptCacheStats( int &iHitsOut, int &iMissesOut )
+{
+	iHitsOut = g_iScriptCacheHits;
+	iMissesOut = g_iScriptCacheMisses;
+}
+
 
 bool LuaHelpers::LoadScript( Lua *L, const RString &sScript, const RString &sName, RString &sError )
 {
@@ -895,14 +1016,38 @@ bool LuaHelpers::RunExpression( Lua *L, const RString &sExpression, const RStrin
 	return true;
 }
 
+namespace
+{
+	/* Bytecode of command lists that have already been converted to Lua and
+	 * compiled, keyed by name and source.  The same lists are parsed again on
+	 * every screen load and metrics reload. */
+	std::map<RString, RString> g_CompiledCommandLists;
+	const std::size_t MAX_COMPILED_COMMAND_LISTS = 4096;
+}
+
 void LuaHelpers::ParseCommandList( Lua *L, const RString &sCommands, const RString &sName, bool bLegacy )
 {
+	// The key to store the compiled list under, if it isn't already compiled.
+	RString sKey;
+	std::map<RString, RString>::const_iterator it = g_CompiledCommandLists.end();
+	if( sCommands.size() == 0 || sCommands[0] != '\033' )
+	{
+		sKey = (bLegacy? "1":"0") + sName + '\n' + sCommands;
+		it = g_CompiledCommandLists.find( sKey );
+		if( it != g_CompiledCommandLists.end() )
+			sKey = RString();
+	}
+
 	RString sLuaFunction;
 	if( sCommands.size() > 0 && sCommands[0] == '\033' )
 	{
 		// This is a compiled Lua chunk. Just pass it on directly.
 		sLuaFunction = sCommands;
 	}
+	else if( it != g_CompiledCommandLists.end() )
+	{
+		sLuaFunction = it->second;
+	}
 	else if( sCommands.size() > 0 && sCommands[0] == '%' )
 	{
 		sLuaFunction = "return ";
@@ -977,8 +1122,23 @@ void LuaHelpers::ParseCommandList( Lua *L, const RString &sCommands, const RStri
 	}
 
 	RString sError;
-	if( !LuaHelpers::RunScript(L, sLuaFunction, sName, sError, 0, 1) )
+	if( !LuaHelpers::LoadScript(L, sLuaFunction, sName, sError) )
+	{
 		LOG->Warn( "Compiling \"%s\": %s", sLuaFunction.c_str(), sError.c_str() );
+		lua_pushnil( L );
+		return;
+	}
+
+	if( !sKey.empty() )
+	{
+		if( g_CompiledCommandLists.size() >= MAX_COMPILED_COMMAND_LISTS )
+			g_CompiledCommandLists.clear();
+		RString &sBytecode = g_CompiledCommandLists[sKey];
+		lua_dump( L, WriteBytecode, &sBytecode );
+	}
+
+	if( !LuaHelpers::RunScriptOnStack(L, sError, 0, 1) )
+		LOG->Warn( "Compiling \"%s\": %s", sName.c_str(), sError.c_str() );
 
 	// The function is now on the stack.
 }
@@ -1162,6 +1322,17 @@ namespace
 		return 0;
 	}
 
+	// Returns the number of script files loaded from the bytecode cache, and
+	// the number compiled from source.
+	static int GetScriptCacheStats( lua_State *L )
+	{
+		int iHits, iMisses;
+		LuaHelpers::GetScriptCacheStats( iHits, iMisses );
+		lua_pushinteger( L, iHits );
+		lua_pushinteger( L, iMisses );
+		return 2;
+	}
+
 	const luaL_Reg luaTable[] =
 	{
 		LIST_METHOD( Trace ),
@@ -1172,6 +1343,7 @@ namespace
 		LIST_METHOD( RunWithThreadVariables ),
 		LIST_METHOD( GetThreadVariable ),
 		LIST_METHOD( ReportScriptError ),
+		LIST_METHOD( GetScriptCacheStats ),
 		{ nullptr, nullptr }
 	};
 }
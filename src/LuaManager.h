@@ -50,6 +50,13 @@ public:
 	void SetGlobal( const RString &sName, const RString &val );
 	void UnsetGlobal( const RString &sName );
 
+	/* Called once a frame, after drawing.  If LuaGCBudgetMilliseconds is set,
+	 * Lua's automatic collector is kept stopped and the incremental collector
+	 * is run here for about that long instead, so collections don't land in
+	 * the middle of an update. */
+	void StepGarbageCollector( bool bInGameplay );
+	RString GetGarbageCollectorStats();
+
 private:
 	lua_State *m_pLuaMain;
 	// Swallow up warnings. If they must be used, define them.
@@ -68,6 +75,12 @@ namespace LuaHelpers
 	 * and the stack is unchanged. */
 	bool LoadScript( Lua *L, const RString &sScript, const RString &sName, RString &sError );
 
+	/* LoadScript the given file, named "@sFile".  Compiled chunks are kept in
+	 * memory and reused until the file's size or modification time changes.
+	 * If the file can't be read, false is returned and sError is left empty. */
+	bool LoadScriptFile( Lua *L, const RString &sFile, RString &sError );
+	void GetScriptCacheStats( int &iHitsOut, int &iMissesOut );
+
 	/* Report the error three ways:  Broadcast message, Warn, and Dialog. */
 	/* If UseAbort is true, reports the error through Dialog::AbortRetryIgnore
 		 and returns the result. */
@@ -6,8 +6,10 @@
 #include "LuaManager.h"
 #include "RageLog.h"
 
+#include <atomic>
 #include <set>
-#include <map>
+#include <string>
+#include <unordered_map>
 
 MessageManager*	MESSAGEMAN = nullptr;	// global and accessible from anywhere in our program
 
@@ -93,25 +95,49 @@ XToString( MessageID );
 static RageMutex g_Mutex( "MessageManager" );
 
 typedef std::set<IMessageSubscriber*> SubscribersSet;
-static std::map<RString,SubscribersSet> g_MessageToSubscribers;
+
+namespace
+{
+	struct MessageSubscribers
+	{
+		SubscribersSet m_Subscribers;
+		/* Read without g_Mutex, so broadcasting a message nobody listens to
+		 * doesn't lock. */
+		std::atomic<int> m_iNumSubscribers{0};
+	};
+
+	struct RStringHash
+	{
+		std::size_t operator()( const RString &s ) const { return std::hash<std::string>()( s ); }
+	};
+}
+
+/* Each message name is interned here the first time it's subscribed to.
+ * Elements of an unordered_map never move, so the entries for MessageIDs are
+ * looked up once and broadcast by index afterwards. */
+static std::unordered_map<RString,MessageSubscribers,RStringHash> g_MessageToSubscribers;
+static MessageSubscribers *g_pMessageIDSubscribers[NUM_MessageID];
 
 Message::Message( const RString &s )
 {
 	m_sName = s;
-	m_pParams = new LuaTable;
+	m_ID = MessageID_Invalid;
+	m_pParams = nullptr;
 	m_bBroadcast = false;
 }
 
 Message::Message(const MessageID id)
 {
 	m_sName= MessageIDToString(id);
-	m_pParams = new LuaTable;
+	m_ID = id;
+	m_pParams = nullptr;
 	m_bBroadcast = false;
 }
 
 Message::Message( const RString &s, const LuaReference &params )
 {
 	m_sName = s;
+	m_ID = MessageID_Invalid;
 	m_bBroadcast = false;
 	Lua *L = LUA->Get();
 	m_pParams = new LuaTable; // XXX: creates an extra table
@@ -126,37 +152,55 @@ Message::~Message()
 	delete m_pParams;
 }
 
+LuaTable &Message::GetParams() const
+{
+	if( m_pParams == nullptr )
+		m_pParams = new LuaTable;
+	return *m_pParams;
+}
+
 void Message::PushParamTable( lua_State *L )
 {
-	m_pParams->PushSelf( L );
+	GetParams().PushSelf( L );
 }
 
 void Message::SetParamTable( const LuaReference &params )
 {
 	Lua *L = LUA->Get();
 	params.PushSelf( L );
-	m_pParams->SetFromStack( L );
+	GetParams().SetFromStack( L );
 	LUA->Release( L );
 }
 
 const LuaReference &Message::GetParamTable() const
 {
-	return *m_pParams;
+	return GetParams();
 }
 
 void Message::GetParamFromStack( lua_State *L, const RString &sName ) const
 {
+	if( m_pParams == nullptr )
+	{
+		lua_pushnil( L );
+		return;
+	}
 	m_pParams->Get( L, sName );
 }
 
 void Message::SetParamFromStack( lua_State *L, const RString &sName )
 {
-	m_pParams->Set( L, sName );
+	GetParams().Set( L, sName );
 }
 
 MessageManager::MessageManager()
 {
 	m_Logging= false;
+	{
+		LockMut(g_Mutex);
+		FOREACH_ENUM( MessageID, m )
+			g_pMessageIDSubscribers[m] = &g_MessageToSubscribers[MessageIDToString(m)];
+	}
+
 	// Register with Lua.
 	{
 		Lua *L = LUA->Get();
@@ -177,12 +221,13 @@ void MessageManager::Subscribe( IMessageSubscriber* pSubscriber, const RString&
 {
 	LockMut(g_Mutex);
 
-	SubscribersSet& subs = g_MessageToSubscribers[sMessage];
+	MessageSubscribers& subs = g_MessageToSubscribers[sMessage];
 #ifdef DEBUG
-	SubscribersSet::iterator iter = subs.find(pSubscriber);
-	ASSERT_M( iter == subs.end(), ssprintf("already subscribed to '%s'",sMessage.c_str()) );
+	SubscribersSet::iterator iter = subs.m_Subscribers.find(pSubscriber);
+	ASSERT_M( iter == subs.m_Subscribers.end(), ssprintf("already subscribed to '%s'",sMessage.c_str()) );
 #endif
-	subs.insert( pSubscriber );
+	if( subs.m_Subscribers.insert(pSubscriber).second )
+		++subs.m_iNumSubscribers;
 }
 
 void MessageManager::Subscribe( IMessageSubscriber* pSubscriber, MessageID m )
@@ -194,10 +239,11 @@ void MessageManager::Unsubscribe( IMessageSubscriber* pSubscriber, const RString
 {
 	LockMut(g_Mutex);
 
-	SubscribersSet& subs = g_MessageToSubscribers[sMessage];
-	SubscribersSet::iterator iter = subs.find(pSubscriber);
-	ASSERT( iter != subs.end() );
-	subs.erase( iter );
+	MessageSubscribers& subs = g_MessageToSubscribers[sMessage];
+	SubscribersSet::iterator iter = subs.m_Subscribers.find(pSubscriber);
+	ASSERT( iter != subs.m_Subscribers.end() );
+	subs.m_Subscribers.erase( iter );
+	--subs.m_iNumSubscribers;
 }
 
 void MessageManager::Unsubscribe( IMessageSubscriber* pSubscriber, MessageID m )
@@ -213,13 +259,27 @@ void MessageManager::Broadcast( Message &msg ) const
 	}
 	msg.SetBroadcast(true);
 
+	MessageSubscribers *pSubs = nullptr;
+	if( msg.GetID() != MessageID_Invalid )
+	{
+		pSubs = g_pMessageIDSubscribers[msg.GetID()];
+		if( pSubs->m_iNumSubscribers.load(std::memory_order_relaxed) == 0 )
+			return;
+	}
+
+	/* Subscribers may be added from other threads, and HandleMessage may
+	 * subscribe or unsubscribe, so delivery still holds the lock. */
 	LockMut(g_Mutex);
 
-	std::map<RString, SubscribersSet>::const_iterator iter = g_MessageToSubscribers.find( msg.GetName() );
-	if( iter == g_MessageToSubscribers.end() )
-		return;
+	if( pSubs == nullptr )
+	{
+		auto iter = g_MessageToSubscribers.find( msg.GetName() );
+		if( iter == g_MessageToSubscribers.end() )
+			return;
+		pSubs = &iter->second;
+	}
 
-	for (IMessageSubscriber *subscriber : iter->second)
+	for (IMessageSubscriber *subscriber : pSubs->m_Subscribers)
 	{
 		subscriber->HandleMessage( msg );
 	}
@@ -234,13 +294,18 @@ void MessageManager::Broadcast( const RString& sMessage ) const
 
 void MessageManager::Broadcast( MessageID m ) const
 {
-	Broadcast( MessageIDToString(m) );
+	Message msg(m);
+	Broadcast( msg );
 }
 
 bool MessageManager::IsSubscribedToMessage( IMessageSubscriber* pSubscriber, const RString &sMessage ) const
 {
-	SubscribersSet& subs = g_MessageToSubscribers[sMessage];
-	return subs.find( pSubscriber ) != subs.end();
+	LockMut(g_Mutex);
+
+	auto iter = g_MessageToSubscribers.find( sMessage );
+	if( iter == g_MessageToSubscribers.end() )
+		return false;
+	return iter->second.m_Subscribers.find( pSubscriber ) != iter->second.m_Subscribers.end();
 }	
 
 void IMessageSubscriber::ClearMessages( const RString sMessage )
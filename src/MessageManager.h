@@ -99,8 +99,10 @@ struct Message
 	Message( const RString &s, const LuaReference &params );
 	~Message();
 
-	void SetName( const RString &sName ) { m_sName = sName; }
+	void SetName( const RString &sName ) { m_sName = sName; m_ID = MessageID_Invalid; }
 	RString GetName() const { return m_sName; }
+	/* MessageID_Invalid unless constructed from a MessageID. */
+	MessageID GetID() const { return m_ID; }
 
 	bool IsBroadcast() const { return m_bBroadcast; }
 	void SetBroadcast( bool b ) { m_bBroadcast = b; }
@@ -141,11 +143,16 @@ struct Message
 	}
 
 	bool operator==( const RString &s ) const { return m_sName == s; }
-	bool operator==( MessageID id ) const { return MessageIDToString(id) == m_sName; }
+	bool operator==( MessageID id ) const { return m_ID != MessageID_Invalid ? m_ID == id : MessageIDToString(id) == m_sName; }
 
 private:
+	LuaTable &GetParams() const;
+
 	RString m_sName;
-	LuaTable *m_pParams;
+	MessageID m_ID;
+	/* Created the first time a parameter is set or the table is used, since
+	 * most broadcasts never look at it. */
+	mutable LuaTable *m_pParams;
 	bool m_bBroadcast;
 
 	Message &operator=( const Message &rhs ); // don't use
@@ -223,7 +230,7 @@ private:
 public:
 	explicit BroadcastOnChange( MessageID m ) { mSendWhenChanged = m; }
 	const T Get() const { return val; }
-	void Set( T t ) { val = t; MESSAGEMAN->Broadcast( MessageIDToString(mSendWhenChanged) ); }
+	void Set( T t ) { val = t; MESSAGEMAN->Broadcast( mSendWhenChanged ); }
 	operator T () const { return val; }
 	bool operator == ( const T &other ) const { return val == other; }
 	bool operator != ( const T &other ) const { return val != other; }
@@ -263,7 +270,7 @@ private:
 public:
 	explicit BroadcastOnChangePtr( MessageID m ) { mSendWhenChanged = m; val = nullptr; }
 	T* Get() const { return val; }
-	void Set( T* t ) { val = t; if(MESSAGEMAN) MESSAGEMAN->Broadcast( MessageIDToString(mSendWhenChanged) ); }
+	void Set( T* t ) { val = t; if(MESSAGEMAN) MESSAGEMAN->Broadcast( mSendWhenChanged ); }
 	/* This is only intended to be used for setting temporary values; always
 	 * restore the original value when finished, so listeners don't get confused
 	 * due to missing a message. */
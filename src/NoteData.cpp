@@ -12,15 +12,23 @@
 #include "GameState.h" // blame radar calculations.
 #include "RageUtil_AutoPtr.h"
 
+#include <atomic>
 #include <cstddef>
 #include <vector>
 
 
 REGISTER_CLASS_TRAITS( NoteData, new NoteData(*pCopy) )
 
+unsigned NoteData::Revision::Next()
+{
+	static std::atomic<unsigned> g_iNextRevision( 1 );
+	return g_iNextRevision.fetch_add( 1 );
+}
+
 void NoteData::Init()
 {
 	m_TapNotes = std::vector<TrackMap>();	// ensure that the memory is freed
+	m_Revision.Bump();
 }
 
 void NoteData::SetNumTracks( int iNewNumTracks )
@@ -28,6 +36,7 @@ void NoteData::SetNumTracks( int iNewNumTracks )
 	ASSERT( iNewNumTracks > 0 );
 
 	m_TapNotes.resize( iNewNumTracks );
+	m_Revision.Bump();
 }
 
 bool NoteData::IsComposite() const
@@ -44,6 +53,8 @@ bool NoteData::IsComposite() const
 // Clear (rowBegin,rowEnd).
 void NoteData::ClearRangeForTrack( int rowBegin, int rowEnd, int iTrack )
 {
+	m_Revision.Bump();
+
 	// Optimization: if the range encloses everything, just clear the whole maps.
 	if( rowBegin == 0 && rowEnd == MAX_NOTE_ROW )
 	{
@@ -123,6 +134,7 @@ void NoteData::ClearAll()
 {
 	for( int t=0; t<GetNumTracks(); t++ )
 		m_TapNotes[t].clear();
+	m_Revision.Bump();
 }
 
 /* Copy [rowFromBegin,rowFromEnd) from pFrom to this. (Note that this does
@@ -940,6 +952,7 @@ void NoteData::MoveTapNoteTrack( int dest, int src )
 	if(dest == src) return;
 	m_TapNotes[dest] = m_TapNotes[src];
 	m_TapNotes[src].clear();
+	m_Revision.Bump();
 }
 
 void NoteData::SetTapNote( int track, int row, const TapNote& t )
@@ -949,6 +962,8 @@ void NoteData::SetTapNote( int track, int row, const TapNote& t )
 	if( row < 0 )
 		return;
 
+	m_Revision.Bump();
+
 	// There's no point in inserting empty notes into the map.
 	// Any blank space in the map is defined to be empty.
 	// If we're trying to insert an empty at a spot where another note
@@ -55,6 +55,8 @@ public:
 		m_TapNotes.swap(nd.m_TapNotes);
 		m_atis.swap(nd.m_atis);
 		m_const_atis.swap(nd.m_const_atis);
+		m_Revision.Bump();
+		nd.m_Revision.Bump();
 	}
 
 
@@ -112,6 +114,25 @@ private:
 	// Any blank space in the map is defined to be empty.
 	std::vector<TrackMap>	m_TapNotes;
 
+	/* Changes whenever notes are added to or removed from the tracks, so that
+	 * anything holding on to iterators into them can tell they may be stale.
+	 * A copy gets a new value, since its iterators are unrelated. */
+	class Revision
+	{
+	public:
+		Revision(): m_iValue(Next()) {}
+		Revision( const Revision & ): m_iValue(Next()) {}
+		Revision( Revision &&other ): m_iValue(Next()) { other.Bump(); }
+		Revision &operator=( const Revision & ) { Bump(); return *this; }
+		Revision &operator=( Revision &&other ) { Bump(); other.Bump(); return *this; }
+		void Bump() { m_iValue = Next(); }
+		unsigned Get() const { return m_iValue; }
+	private:
+		static unsigned Next();
+		unsigned m_iValue;
+	};
+	Revision m_Revision;
+
 	/**
 	 * @brief Determine whether this note is for Player 1 or Player 2.
 	 * @param track the track/column the note is in.
@@ -174,6 +195,7 @@ public:
 	int GetNumTracks() const { return m_TapNotes.size(); }
 	void SetNumTracks( int iNewNumTracks );
 	bool IsComposite() const;
+	unsigned GetRevision() const { return m_Revision.Get(); }
 	bool operator==( const NoteData &nd ) const			{ return m_TapNotes == nd.m_TapNotes; }
 	bool operator!=( const NoteData &nd ) const			{ return m_TapNotes != nd.m_TapNotes; }
 
@@ -192,7 +214,7 @@ public:
 
 	inline iterator FindTapNote( unsigned iTrack, int iRow )	{ return m_TapNotes[iTrack].find( iRow ); }
 	inline const_iterator FindTapNote( unsigned iTrack, int iRow ) const { return m_TapNotes[iTrack].find( iRow ); }
-	void RemoveTapNote( unsigned iTrack, iterator it )		{ m_TapNotes[iTrack].erase( it ); }
+	void RemoveTapNote( unsigned iTrack, iterator it )		{ m_TapNotes[iTrack].erase( it ); m_Revision.Bump(); }
 
 	/**
 	 * @brief Return an iterator range for [rowBegin,rowEnd).
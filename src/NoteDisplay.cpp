@@ -20,7 +20,9 @@
 #include "Style.h"
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <vector>
 
 
@@ -413,6 +415,8 @@ void NoteColumnRenderArgs::SetPRZForActor(Actor* actor,
 NoteDisplay::NoteDisplay()
 {
 	cache = new NoteMetricCache_t;
+	m_bBatchTapQuads = false;
+	m_pQuadBatchActor = nullptr;
 }
 
 NoteDisplay::~NoteDisplay()
@@ -542,22 +546,82 @@ bool NoteDisplay::DrawHoldsInRange(const NoteFieldRenderArgs& field_args,
 	return any_upcoming;
 }
 
+void NoteDisplay::tap_batch::resize(std::size_t size)
+{
+	beat.resize(size);
+	y_offset.resize(size);
+	fade.resize(size);
+	x.resize(size);
+	y.resize(size);
+	z.resize(size);
+	rot_x.resize(size);
+	rot_y.resize(size);
+	rot_z.resize(size);
+	zoom.resize(size);
+	alpha.resize(size);
+	glow.resize(size);
+}
+
 bool NoteDisplay::DrawTapsInRange(const NoteFieldRenderArgs& field_args,
 	const NoteColumnRenderArgs& column_args,
 	const std::vector<NoteData::TrackMap::const_iterator>& tap_set)
 {
 	bool any_upcoming= false;
 
-	auto loop_body = [this, &field_args, &column_args, &any_upcoming](const NoteData::TrackMap::const_iterator& tapit)
+	// Evaluate ArrowEffects for the whole column up front, instead of once
+	// per call for every note.  The spline modes mix their own results in
+	// per note, so the rest of the effects are only batched without them.
+	const int num_taps= static_cast<int>(tap_set.size());
+	tap_batch& batch= m_TapBatch;
+	batch.resize(num_taps);
+	for(int i= 0; i < num_taps; ++i)
 	{
-		int tap_row= tapit->first;
-		const TapNote& tn= tapit->second;
+		const int tap_row= tap_set[i]->first;
+		bool in_selection_range = false;
+		if(*field_args.selection_begin_marker != -1 && *field_args.selection_end_marker != -1)
+		{
+			in_selection_range = *field_args.selection_begin_marker <= tap_row &&
+				tap_row < *field_args.selection_end_marker;
+		}
+		batch.beat[i]= NoteRowToVisibleBeat(m_pPlayerState, tap_row);
+		batch.fade[i]= in_selection_range ? field_args.selection_glow : field_args.fail_fade;
+	}
+	ArrowEffects::GetYOffsets(m_pPlayerState, column_args.column,
+		batch.beat.data(), batch.y_offset.data(), num_taps);
+	batch.has_effects= column_args.pos_handler->m_spline_mode == NCSM_Disabled &&
+		column_args.rot_handler->m_spline_mode == NCSM_Disabled &&
+		column_args.zoom_handler->m_spline_mode == NCSM_Disabled;
+	if(batch.has_effects)
+	{
+		ArrowEffects::GetXYZPositions(m_pPlayerState, column_args.column,
+			batch.y_offset.data(), m_fYReverseOffsetPixels,
+			batch.x.data(), batch.y.data(), batch.z.data(), num_taps);
+		ArrowEffects::GetRotations(m_pPlayerState, column_args.column,
+			batch.beat.data(), batch.y_offset.data(),
+			batch.rot_x.data(), batch.rot_y.data(), batch.rot_z.data(), num_taps);
+		ArrowEffects::GetZooms(m_pPlayerState, column_args.column,
+			batch.y_offset.data(), batch.zoom.data(), num_taps);
+		ArrowEffects::GetAlphasAndGlows(m_pPlayerState, column_args.column,
+			batch.y_offset.data(), batch.fade.data(), m_fYReverseOffsetPixels,
+			field_args.draw_pixels_before_targets, field_args.fade_before_targets,
+			batch.alpha.data(), batch.glow.data(), num_taps);
+	}
+
+	// IsOnScreen compares against whole pixels.
+	const int draw_pixels_after_targets= field_args.draw_pixels_after_targets;
+	const int draw_pixels_before_targets= field_args.draw_pixels_before_targets;
+
+	auto loop_body = [this, &field_args, &column_args, &any_upcoming, &tap_set,
+		&batch, draw_pixels_after_targets, draw_pixels_before_targets](int i)
+	{
+		int tap_row= tap_set[i]->first;
+		const TapNote& tn= tap_set[i]->second;
 
 		// TRICKY: If boomerang is on, then all notes in the range
 		// [first_row,last_row] aren't necessarily visible.
 		// Test every note to make sure it's on screen before drawing.
-		if(!IsOnScreen(NoteRowToBeat(tap_row), column_args.column,
-				field_args.draw_pixels_after_targets, field_args.draw_pixels_before_targets))
+		if(batch.y_offset[i] > draw_pixels_before_targets ||
+			batch.y_offset[i] < draw_pixels_after_targets)
 		{
 			return; // skip
 		}
@@ -605,43 +669,76 @@ bool NoteDisplay::DrawTapsInRange(const NoteFieldRenderArgs& field_args,
 			}
 		}
 
-		bool in_selection_range = false;
-		if(*field_args.selection_begin_marker != -1 && *field_args.selection_end_marker != -1)
-		{
-			in_selection_range = *field_args.selection_begin_marker <= tap_row &&
-				tap_row < *field_args.selection_end_marker;
-		}
-
 		bool is_addition = (tn.source == TapNoteSource_Addition);
-		DrawTap(tn, field_args, column_args,
-			NoteRowToVisibleBeat(m_pPlayerState, tap_row),
+		DrawTap(tn, field_args, column_args, batch.beat[i],
 			hold_begins_on_this_beat, roll_begins_on_this_beat,
-			is_addition,
-			in_selection_range ? field_args.selection_glow : field_args.fail_fade);
+			is_addition, batch.fade[i], i);
 
 		any_upcoming |= NoteRowToBeat(tap_row) >
 			m_pPlayerState->GetDisplayedPosition().m_fSongBeat;
 
-		if(!PREFSMAN->m_FastNoteRendering)
+		// Notes in a quad batch don't touch the z buffer.
+		if(!PREFSMAN->m_FastNoteRendering && m_pQuadBatchActor == nullptr)
 		{
 			DISPLAY->ClearZBuffer();
 		}
 	};
 
+	m_bBatchTapQuads= true;
+
 	if (g_bRenderEarlierNotesOnTop.Get())
 	{
 		// draw notes from closest to furthest
-		std::for_each(tap_set.rbegin(), tap_set.rend(), loop_body);
+		for(int i= num_taps-1; i >= 0; --i)
+		{
+			loop_body(i);
+		}
 	}
 	else
 	{
 		// draw notes from furthest to closest
-		std::for_each(tap_set.begin(), tap_set.end(), loop_body);
+		for(int i= 0; i < num_taps; ++i)
+		{
+			loop_body(i);
+		}
 	}
+	EndTapQuadBatch();
+	m_bBatchTapQuads= false;
 
 	return any_upcoming;
 }
 
+bool NoteDisplay::CanBatchTapActor(Actor* pActor, float fGlow) const
+{
+	// Everything in a batch is drawn with the render state left by the last
+	// note, so only Sprites that set the same state every time qualify.
+	// ActorFrames and Models can change it between their parts, the glow pass
+	// changes the texture mode, and effects can turn the glow on.  The glow
+	// can also come from the noteskin's own glow or an internal glow, not
+	// just from ArrowEffects.
+	const Sprite* pSprite= dynamic_cast<const Sprite*>(pActor);
+	if(pSprite == nullptr || fGlow > 0 || pSprite->HasGlow() ||
+		pSprite->GetEffect() != Actor::no_effect ||
+		pSprite->GetEffectMode() != EffectMode_Normal ||
+		pSprite->GetClearZBuffer())
+	{
+		return false;
+	}
+	// Without FastNoteRendering, the z buffer is cleared between notes, so
+	// only notes that don't use it can be drawn together.
+	return PREFSMAN->m_FastNoteRendering ||
+		(pSprite->GetZTestMode() == ZTEST_OFF && !pSprite->GetZWrite());
+}
+
+void NoteDisplay::EndTapQuadBatch()
+{
+	if(m_pQuadBatchActor != nullptr)
+	{
+		DISPLAY->EndQuadBatch();
+		m_pQuadBatchActor= nullptr;
+	}
+}
+
 bool NoteDisplay::DrawHoldHeadForTapsOnSameRow() const
 {
 	return cache->m_bDrawHoldHeadForTapsOnSameRow;
@@ -848,6 +945,26 @@ void NoteDisplay::DrawHoldPart(std::vector<Sprite*> &vpSpr,
 	// pos_z_vec will be used later to orient the hold.  Read below. -Kyz
 	static const RageVector3 pos_z_vec(0.0f, 0.0f, 1.0f);
 	static const RageVector3 pos_y_vec(0.0f, 1.0f, 0.0f);
+
+	// If no mod bends, twists or resizes the hold along its length, the strip
+	// is straight, and its position, zoom and rotation are the same for every
+	// slice.  Look them up once for the part instead of once per slice.
+	const bool static_shape=
+		column_args.pos_handler->m_spline_mode == NCSM_Disabled &&
+		column_args.rot_handler->m_spline_mode == NCSM_Disabled &&
+		column_args.zoom_handler->m_spline_mode == NCSM_Disabled &&
+		ArrowEffects::IsHoldShapeStatic(column_args.column);
+	RageVector3 static_pos;
+	float static_rot_y= 0;
+	float static_variable_zoom= 1;
+	if(static_shape)
+	{
+		static_pos.x= ArrowEffects::GetXPos(m_pPlayerState, column_args.column, 0);
+		static_pos.z= ArrowEffects::GetZPos(m_pPlayerState, column_args.column, 0);
+		static_rot_y= ArrowEffects::GetRotationY(m_pPlayerState, 0, column_args.column) * -PI_180;
+		static_variable_zoom= ArrowEffects::GetZoomVariable(0, column_args.column, 1) / ArrowEffects::GetPulseInner();
+	}
+
 	StripBuffer queue;
 	for(float fY = y_start_pos; !last_vert_set; fY += part_args.y_step)
 	{
@@ -859,7 +976,10 @@ void NoteDisplay::DrawHoldPart(std::vector<Sprite*> &vpSpr,
 
 		const float fYOffset= ArrowEffects::GetYOffsetFromYPos(column_args.column, fY, m_fYReverseOffsetPixels);
 
-		ae_zoom = ArrowEffects::GetZoom(m_pPlayerState, fYOffset, column_args.column);
+		if(!static_shape)
+		{
+			ae_zoom = ArrowEffects::GetZoom(m_pPlayerState, fYOffset, column_args.column);
+		}
 
 		float cur_beat= part_args.top_beat;
 		if(part_args.top_beat != part_args.bottom_beat)
@@ -899,8 +1019,15 @@ void NoteDisplay::DrawHoldPart(std::vector<Sprite*> &vpSpr,
 		// maintain the old behavior of how holds are drawn when they wave back
 		// and forth. -Kyz
 		RageVector3 render_forward(0.0f, 1.0f, 0.0f);
-		column_args.spae_pos_for_beat(m_pPlayerState, cur_beat,
-			fYOffset, m_fYReverseOffsetPixels, sp_pos, ae_pos);
+		if(static_shape)
+		{
+			ae_pos= static_pos;
+		}
+		else
+		{
+			column_args.spae_pos_for_beat(m_pPlayerState, cur_beat,
+				fYOffset, m_fYReverseOffsetPixels, sp_pos, ae_pos);
+		}
 		// fX and fZ are sp_pos.x + ae_pos.x and sp_pos.z + ae_pos.z. -Kyz
 		// fY is the actual y position that should be used, not whatever spae
 		// fetched from ArrowEffects. -Kyz
@@ -960,7 +1087,8 @@ void NoteDisplay::DrawHoldPart(std::vector<Sprite*> &vpSpr,
 		{
 			case NCSM_Disabled:
 				// XXX: Actor rotations use degrees, Math uses radians. Convert here.
-				ae_rot.y= ArrowEffects::GetRotationY(m_pPlayerState, fYOffset, column_args.column) * -PI_180;
+				ae_rot.y= static_shape ? static_rot_y :
+					ArrowEffects::GetRotationY(m_pPlayerState, fYOffset, column_args.column) * -PI_180;
 				break;
 			case NCSM_Offset:
 				ae_rot.y= ArrowEffects::GetRotationY(m_pPlayerState, fYOffset, column_args.column) * -PI_180;
@@ -1009,8 +1137,8 @@ void NoteDisplay::DrawHoldPart(std::vector<Sprite*> &vpSpr,
 
 		// Hack: because some mods mess with the zoom, we need to compensate accordingly,
 		// or else hold ends don't look right.
-		const float fPulseInnerAdj	= ArrowEffects::GetPulseInner();
-		const float fVariableZoom	= ArrowEffects::GetZoomVariable(fYOffset, column_args.column, 1) / fPulseInnerAdj;
+		const float fVariableZoom	= static_shape ? static_variable_zoom :
+			ArrowEffects::GetZoomVariable(fYOffset, column_args.column, 1) / ArrowEffects::GetPulseInner();
 
 		const float fDistFromTop	= (fY - y_start_pos) / ae_zoom;
 		float fTexCoordTop		= SCALE(fDistFromTop, 0, unzoomed_frame_height, rect.top, rect.bottom * fVariableZoom);
@@ -1266,7 +1394,7 @@ void NoteDisplay::DrawHold(const TapNote& tn,
 void NoteDisplay::DrawActor(const TapNote& tn, Actor* pActor, NotePart part,
 	const NoteFieldRenderArgs& field_args, const NoteColumnRenderArgs& column_args, float fYOffset, float fBeat,
 	bool bIsAddition, float fPercentFadeToFail, float fColorScale,
-	bool is_being_held)
+	bool is_being_held, int batch_index)
 {
 	if (tn.type == TapNoteType_AutoKeysound && !GAMESTATE->m_bInStepEditor) return;
 	if(fYOffset < field_args.draw_pixels_after_targets ||
@@ -1277,8 +1405,11 @@ void NoteDisplay::DrawActor(const TapNote& tn, Actor* pActor, NotePart part,
 	float spline_beat= fBeat;
 	if(is_being_held) { spline_beat= column_args.song_beat; }
 
-	const float fAlpha= ArrowEffects::GetAlpha(m_pPlayerState, column_args.column, fYOffset, fPercentFadeToFail, m_fYReverseOffsetPixels, field_args.draw_pixels_before_targets, field_args.fade_before_targets);
-	const float fGlow= ArrowEffects::GetGlow(m_pPlayerState, column_args.column, fYOffset, fPercentFadeToFail, m_fYReverseOffsetPixels, field_args.draw_pixels_before_targets, field_args.fade_before_targets);
+	const bool batched= batch_index >= 0;
+	const float fAlpha= batched ? m_TapBatch.alpha[batch_index] :
+		ArrowEffects::GetAlpha(m_pPlayerState, column_args.column, fYOffset, fPercentFadeToFail, m_fYReverseOffsetPixels, field_args.draw_pixels_before_targets, field_args.fade_before_targets);
+	const float fGlow= batched ? m_TapBatch.glow[batch_index] :
+		ArrowEffects::GetGlow(m_pPlayerState, column_args.column, fYOffset, fPercentFadeToFail, m_fYReverseOffsetPixels, field_args.draw_pixels_before_targets, field_args.fade_before_targets);
 	const RageColor diffuse	= RageColor(
 		column_args.diffuse.r * fColorScale,
 		column_args.diffuse.g * fColorScale,
@@ -1315,29 +1446,40 @@ void NoteDisplay::DrawActor(const TapNote& tn, Actor* pActor, NotePart part,
 	RageVector3 ae_pos;
 	RageVector3 ae_rot;
 	RageVector3 ae_zoom;
-	column_args.spae_pos_for_beat(m_pPlayerState, spline_beat,
-		fYOffset, m_fYReverseOffsetPixels, sp_pos, ae_pos);
-
-	switch(column_args.rot_handler->m_spline_mode)
+	if(batched)
 	{
-		case NCSM_Disabled:
-			ae_rot.x= ArrowEffects::GetRotationX(m_pPlayerState, fYOffset, bIsHoldCap, column_args.column);
-			ae_rot.y= ArrowEffects::GetRotationY(m_pPlayerState, fYOffset, column_args.column);
-			ae_rot.z= ArrowEffects::GetRotationZ(m_pPlayerState, fBeat, bIsHoldHead, column_args.column);
-			break;
-		case NCSM_Offset:
-			ae_rot.x= ArrowEffects::GetRotationX(m_pPlayerState, fYOffset, bIsHoldCap, column_args.column);
-			ae_rot.y= ArrowEffects::GetRotationY(m_pPlayerState, fYOffset, column_args.column);
-			ae_rot.z= ArrowEffects::GetRotationZ(m_pPlayerState, fBeat, bIsHoldHead, column_args.column);
-			column_args.rot_handler->EvalForBeat(column_args.song_beat, spline_beat, sp_rot);
-			break;
-		case NCSM_Position:
-			column_args.rot_handler->EvalForBeat(column_args.song_beat, spline_beat, sp_rot);
-			break;
-		default:
-			break;
+		// The batch is only filled in when splines are disabled, so sp_* stay
+		// zero.
+		ae_pos= RageVector3(m_TapBatch.x[batch_index], m_TapBatch.y[batch_index], m_TapBatch.z[batch_index]);
+		ae_rot= RageVector3(m_TapBatch.rot_x[batch_index], m_TapBatch.rot_y[batch_index], m_TapBatch.rot_z[batch_index]);
+		ae_zoom.x= ae_zoom.y= ae_zoom.z= m_TapBatch.zoom[batch_index];
+	}
+	else
+	{
+		column_args.spae_pos_for_beat(m_pPlayerState, spline_beat,
+			fYOffset, m_fYReverseOffsetPixels, sp_pos, ae_pos);
+
+		switch(column_args.rot_handler->m_spline_mode)
+		{
+			case NCSM_Disabled:
+				ae_rot.x= ArrowEffects::GetRotationX(m_pPlayerState, fYOffset, bIsHoldCap, column_args.column);
+				ae_rot.y= ArrowEffects::GetRotationY(m_pPlayerState, fYOffset, column_args.column);
+				ae_rot.z= ArrowEffects::GetRotationZ(m_pPlayerState, fBeat, bIsHoldHead, column_args.column);
+				break;
+			case NCSM_Offset:
+				ae_rot.x= ArrowEffects::GetRotationX(m_pPlayerState, fYOffset, bIsHoldCap, column_args.column);
+				ae_rot.y= ArrowEffects::GetRotationY(m_pPlayerState, fYOffset, column_args.column);
+				ae_rot.z= ArrowEffects::GetRotationZ(m_pPlayerState, fBeat, bIsHoldHead, column_args.column);
+				column_args.rot_handler->EvalForBeat(column_args.song_beat, spline_beat, sp_rot);
+				break;
+			case NCSM_Position:
+				column_args.rot_handler->EvalForBeat(column_args.song_beat, spline_beat, sp_rot);
+				break;
+			default:
+				break;
+		}
+		column_args.spae_zoom_for_beat(m_pPlayerState, spline_beat, sp_zoom, ae_zoom, column_args.column, fYOffset);
 	}
-	column_args.spae_zoom_for_beat(m_pPlayerState, spline_beat, sp_zoom, ae_zoom, column_args.column, fYOffset);
 	column_args.SetPRZForActor(pActor, sp_pos, ae_pos, sp_rot, ae_rot, sp_zoom, ae_zoom);
 	// [AJ] this two lines (and how they're handled) piss off many people:
 	pActor->SetDiffuse( diffuse );
@@ -1373,6 +1515,17 @@ void NoteDisplay::DrawActor(const TapNote& tn, Actor* pActor, NotePart part,
 		DISPLAY->TextureTranslate( (bIsAddition ? cache->m_fAdditionTextureCoordOffset[part] : RageVector2(0,0)) + cache->m_fNoteColorTextureCoordSpacing[part]*color );
 	}
 
+	const bool batch_quads= m_bBatchTapQuads && CanBatchTapActor(pActor, fGlow);
+	if(m_pQuadBatchActor != nullptr && (!batch_quads || m_pQuadBatchActor != pActor))
+	{
+		EndTapQuadBatch();
+	}
+	if(batch_quads && m_pQuadBatchActor == nullptr)
+	{
+		DISPLAY->BeginQuadBatch();
+		m_pQuadBatchActor= pActor;
+	}
+
 	pActor->Draw();
 
 	if( bNeedsTranslate )
@@ -1385,7 +1538,7 @@ void NoteDisplay::DrawTap(const TapNote& tn,
 	const NoteFieldRenderArgs& field_args,
 	const NoteColumnRenderArgs& column_args, float fBeat,
 	bool bOnSameRowAsHoldStart, bool bOnSameRowAsRollStart,
-	bool bIsAddition, float fPercentFadeToFail)
+	bool bIsAddition, float fPercentFadeToFail, int iBatchIndex)
 {
 	Actor* pActor = nullptr;
 	NotePart part = NotePart_Tap;
@@ -1457,9 +1610,13 @@ void NoteDisplay::DrawTap(const TapNote& tn,
 		pActor->HandleMessage( msg );
 	}
 
-	const float fYOffset = ArrowEffects::GetYOffset( m_pPlayerState, column_args.column, fBeat );
+	const float fYOffset = iBatchIndex >= 0 ? m_TapBatch.y_offset[iBatchIndex] :
+		ArrowEffects::GetYOffset( m_pPlayerState, column_args.column, fBeat );
+	// The batched rotations are for plain taps, not hold caps.
+	const bool bUseBatch = iBatchIndex >= 0 && m_TapBatch.has_effects &&
+		tn.type != TapNoteType_HoldHead && tn.type != TapNoteType_HoldTail;
 	// this is the line that forces the (1,1,1,x) part of the noteskin diffuse -aj
-	DrawActor(tn, pActor, part, field_args, column_args, fYOffset, fBeat, bIsAddition, fPercentFadeToFail, 1.0f, false);
+	DrawActor(tn, pActor, part, field_args, column_args, fYOffset, fBeat, bIsAddition, fPercentFadeToFail, 1.0f, false, bUseBatch ? iBatchIndex : -1);
 
 	if( tn.type == TapNoteType_Attack )
 		pActor->PlayCommand( "UnsetAttack" );
@@ -1535,6 +1692,91 @@ void NoteColumnRenderer::UpdateReceptorGhostStuff(Actor* receptor) const
 	receptor->SetInternalGlow(m_column_render_args.glow);
 }
 
+NoteColumnRenderer::NoteColumnRenderer()
+	:m_holds(PLAYER_INVALID+1), m_taps(PLAYER_INVALID+1)
+{
+	m_visible_window.note_data= nullptr;
+	m_visible_window.revision= 0;
+	m_visible_window.column= -1;
+	m_visible_window.first_row= 0;
+	m_visible_window.end_row= 0;
+}
+
+// Walking further than this to slide the window costs more than a search.
+static const int MAX_VISIBLE_WINDOW_STEPS= 32;
+
+template<typename iter>
+static void SlideToRow(const NoteData& note_data, int column, iter& it,
+	int old_row, int new_row)
+{
+	const iter track_begin= note_data.begin(column);
+	const iter track_end= note_data.end(column);
+	int steps= 0;
+	if(new_row > old_row)
+	{
+		while(it != track_end && it->first < new_row)
+		{
+			if(++steps > MAX_VISIBLE_WINDOW_STEPS)
+			{
+				it= note_data.lower_bound(column, new_row);
+				return;
+			}
+			++it;
+		}
+	}
+	else
+	{
+		while(it != track_begin && std::prev(it)->first >= new_row)
+		{
+			if(++steps > MAX_VISIBLE_WINDOW_STEPS)
+			{
+				it= note_data.lower_bound(column, new_row);
+				return;
+			}
+			--it;
+		}
+	}
+}
+
+void NoteColumnRenderer::UpdateVisibleWindow(int first_row, int end_row)
+{
+	// This gives the same range as GetTapNoteRangeInclusive(m_column,
+	// first_row, end_row).
+	const NoteData& note_data= *m_field_render_args->note_data;
+	visible_window& win= m_visible_window;
+	if(win.note_data != &note_data || win.revision != note_data.GetRevision() ||
+		win.column != m_column || first_row > end_row || win.first_row > win.end_row)
+	{
+		win.note_data= &note_data;
+		win.revision= note_data.GetRevision();
+		win.column= m_column;
+		win.lower= note_data.lower_bound(m_column, first_row);
+		win.end= note_data.lower_bound(m_column, end_row);
+	}
+	else
+	{
+		SlideToRow(note_data, m_column, win.lower, win.first_row, first_row);
+		SlideToRow(note_data, m_column, win.end, win.end_row, end_row);
+	}
+	win.first_row= first_row;
+	win.end_row= end_row;
+	win.begin= win.lower;
+	if(first_row > end_row)
+	{
+		win.begin= win.end= note_data.end(m_column);
+		return;
+	}
+	if(win.begin != note_data.begin(m_column))
+	{
+		NoteData::TrackMap::const_iterator prev= std::prev(win.begin);
+		if(prev->second.type == TapNoteType_HoldHead &&
+			prev->first + prev->second.iDuration > first_row)
+		{
+			win.begin= prev;
+		}
+	}
+}
+
 void NoteColumnRenderer::DrawPrimitives()
 {
 	m_column_render_args.song_beat= m_field_render_args->player_state->GetDisplayedPosition().m_fSongBeatVisible;
@@ -1550,11 +1792,19 @@ void NoteColumnRenderer::DrawPrimitives()
 	// lists to the displays to draw.
 	// The vector in the NUM_PlayerNumber slot should stay empty, not worth
 	// optimizing it out. -Kyz
-	std::vector<std::vector<NoteData::TrackMap::const_iterator> > holds(PLAYER_INVALID+1);
-	std::vector<std::vector<NoteData::TrackMap::const_iterator> > taps(PLAYER_INVALID+1);
-	NoteData::TrackMap::const_iterator begin, end;
-	m_field_render_args->note_data->GetTapNoteRangeInclusive(m_column,
-		m_field_render_args->first_row, m_field_render_args->last_row+1, begin, end);
+	std::vector<std::vector<NoteData::TrackMap::const_iterator> >& holds= m_holds;
+	std::vector<std::vector<NoteData::TrackMap::const_iterator> >& taps= m_taps;
+	for(std::size_t pn= 0; pn < holds.size(); ++pn)
+	{
+		holds[pn].clear();
+		taps[pn].clear();
+	}
+	// The notes themselves can change state from frame to frame (hidden when
+	// hit, held), so only the range is kept, and they're sorted again here.
+	UpdateVisibleWindow(m_field_render_args->first_row,
+		m_field_render_args->last_row+1);
+	NoteData::TrackMap::const_iterator begin= m_visible_window.begin;
+	const NoteData::TrackMap::const_iterator end= m_visible_window.end;
 	for(; begin != end; ++begin)
 	{
 		const TapNote& tn= begin->second;
@@ -7,6 +7,7 @@
 #include "PlayerNumber.h"
 #include "GameInput.h"
 
+#include <cstddef>
 #include <vector>
 
 
@@ -206,11 +207,14 @@ public:
 	 * @param fReverseOffsetPixels How are the notes adjusted on Reverse?
 	 * @param fDrawDistanceAfterTargetsPixels how much to draw after the receptors.
 	 * @param fDrawDistanceBeforeTargetsPixels how much ot draw before the receptors.
-	 * @param fFadeInPercentOfDrawFar when to start fading in. */
+	 * @param fFadeInPercentOfDrawFar when to start fading in.
+	 * @param iBatchIndex the note's index in the batch filled by
+	 * DrawTapsInRange, or -1 to evaluate ArrowEffects for this note alone. */
 	void DrawTap(const TapNote& tn, const NoteFieldRenderArgs& field_args,
 		const NoteColumnRenderArgs& column_args, float fBeat,
 		bool bOnSameRowAsHoldStart,
-		bool bOnSameRowAsRollBeat, bool bIsAddition, float fPercentFadeToFail);
+		bool bOnSameRowAsRollBeat, bool bIsAddition, float fPercentFadeToFail,
+		int iBatchIndex= -1);
 	void DrawHold(const TapNote& tn, const NoteFieldRenderArgs& field_args,
 		const NoteColumnRenderArgs& column_args, int iRow, bool bIsBeingHeld,
 		const HoldNoteResult &Result,
@@ -246,7 +250,7 @@ private:
 		const NoteFieldRenderArgs& field_args,
 		const NoteColumnRenderArgs& column_args, float fYOffset, float fBeat,
 		bool bIsAddition, float fPercentFadeToFail, float fColorScale,
-		bool is_being_held);
+		bool is_being_held, int batch_index= -1);
 	void DrawHoldPart(std::vector<Sprite*> &vpSpr,
 		const NoteFieldRenderArgs& field_args,
 		const NoteColumnRenderArgs& column_args,
@@ -277,6 +281,33 @@ private:
 	NoteColorSprite		m_HoldBottomCap[NUM_HoldType][NUM_ActiveType];
 	NoteColorActor		m_HoldTail[NUM_HoldType][NUM_ActiveType];
 	float			m_fYReverseOffsetPixels;
+
+	// While DrawTapsInRange runs, consecutive notes drawn with the same plain
+	// Sprite are collected into one quad batch.  m_pQuadBatchActor is the
+	// Sprite of the open batch, or null.
+	bool CanBatchTapActor(Actor* pActor, float fGlow) const;
+	void EndTapQuadBatch();
+	bool			m_bBatchTapQuads;
+	Actor			*m_pQuadBatchActor;
+
+	// ArrowEffects results for the taps DrawTapsInRange is drawing, stored as
+	// parallel arrays so the whole column is evaluated in one batch.  Kept
+	// between frames so the arrays don't have to be reallocated.
+	struct tap_batch
+	{
+		void resize(std::size_t size);
+		std::vector<float> beat;
+		std::vector<float> y_offset;
+		std::vector<float> fade;
+		std::vector<float> x, y, z;
+		std::vector<float> rot_x, rot_y, rot_z;
+		std::vector<float> zoom;
+		std::vector<float> alpha;
+		std::vector<float> glow;
+		// False if splines are in use, which need the per note path.
+		bool has_effects;
+	};
+	tap_batch		m_TapBatch;
 };
 
 // So, this is a bit screwy, and it's partly because routine forces rendering
@@ -291,6 +322,8 @@ private:
 
 struct NoteColumnRenderer : public Actor
 {
+	NoteColumnRenderer();
+
 	NoteDisplay* m_displays[PLAYER_INVALID+1];
 	NoteFieldRenderArgs* m_field_render_args;
 	NoteColumnRenderArgs m_column_render_args;
@@ -339,6 +372,28 @@ struct NoteColumnRenderer : public Actor
 	std::vector<NCR_TweenState> NCR_Tweens;
 	NCR_TweenState NCR_current;
 	NCR_TweenState NCR_start;
+
+	// The range of notes drawn last frame.  Each frame it's slid forward (or
+	// back) over the notes that scrolled on or off screen instead of being
+	// searched for again, and it's thrown out when the NoteData changes.
+	// lower is the first note at or after first_row; begin is the same unless
+	// a hold starting before first_row reaches into the window.
+	struct visible_window
+	{
+		const NoteData* note_data;
+		unsigned revision;
+		int column;
+		int first_row;
+		int end_row;
+		NoteData::TrackMap::const_iterator lower;
+		NoteData::TrackMap::const_iterator begin;
+		NoteData::TrackMap::const_iterator end;
+	};
+	visible_window m_visible_window;
+	void UpdateVisibleWindow(int first_row, int end_row);
+	// Kept between frames so the lists don't have to be reallocated.
+	std::vector<std::vector<NoteData::TrackMap::const_iterator> > m_holds;
+	std::vector<std::vector<NoteData::TrackMap::const_iterator> > m_taps;
 };
 
 #endif
@@ -165,6 +165,7 @@ static Preference<float> m_fTimingWindowAdd	( "TimingWindowAdd",		0 );
 static Preference1D<float> m_fTimingWindowSeconds( TimingWindowSecondsInit, NUM_TimingWindow );
 static Preference<float> m_fTimingWindowJump	( "TimingWindowJump",		0.25 );
 static Preference<float> m_fMaxInputLatencySeconds	( "MaxInputLatencySeconds",	0.0 );
+static Preference<bool> g_bJudgeFromAudioClock	( "JudgeFromAudioClock",	false );
 static Preference<bool> g_bEnableAttackSoundPlayback	( "EnableAttackSounds", true );
 static Preference<bool> g_bEnableMineSoundPlayback	( "EnableMineHitSound", true );
 static Preference<TapNoteScore> g_MinTNSToScoreNotes	( "MinTNSToScoreNotes", TNS_None, ValidateMinTNSToScoreNotes );  // Default to great and above.
@@ -260,6 +261,12 @@ Player::Player( NoteData &nd, bool bVisibleParts ) : m_NoteData(nd)
 	m_pPlayerState = nullptr;
 	m_pPlayerStageStats = nullptr;
 	m_fNoteFieldHeight = 0;
+	m_fLogicSecondsAhead = 0;
+	m_pMusicClock = nullptr;
+	m_pvReplayPressedSeconds = nullptr;
+	m_iAudioClockSamples = 0;
+	m_fAudioClockErrorSum = 0;
+	m_fAudioClockErrorMax = 0;
 
 	m_pLifeMeter = nullptr;
 	m_pCombinedLifeMeter = nullptr;
@@ -273,6 +280,7 @@ Player::Player( NoteData &nd, bool bVisibleParts ) : m_NoteData(nd)
 	m_pIterUncrossedRows = nullptr;
 	m_pIterUnjudgedRows = nullptr;
 	m_pIterUnjudgedMineRows = nullptr;
+	m_iFirstUnjudgedRowRevision = 0;
 
 	m_bPaused = false;
 	m_bDelay = false;
@@ -299,6 +307,7 @@ Player::Player( NoteData &nd, bool bVisibleParts ) : m_NoteData(nd)
 
 Player::~Player()
 {
+	LogAudioClockStats();
 	SAFE_DELETE( m_pAttackDisplay );
 	SAFE_DELETE( m_pNoteField );
 	for( unsigned i = 0; i < m_vpHoldJudgment.size(); ++i )
@@ -618,22 +627,7 @@ static bool NeedsHoldJudging( const TapNote &tn )
 
 static void GenerateCacheDataStructure(PlayerState *pPlayerState, const NoteData &notes) {
 
-	pPlayerState->m_CacheDisplayedBeat.clear();
-
-	const std::vector<TimingSegment*> vScrolls = pPlayerState->GetDisplayedTiming().GetTimingSegments( SEGMENT_SCROLL );
-
-	float displayedBeat = 0.0f;
-	float lastRealBeat = 0.0f;
-	float lastRatio = 1.0f;
-	for ( unsigned i = 0; i < vScrolls.size(); i++ )
-	{
-		ScrollSegment *seg = ToScroll( vScrolls[i] );
-		displayedBeat += ( seg->GetBeat() - lastRealBeat ) * lastRatio;
-		lastRealBeat = seg->GetBeat();
-		lastRatio = seg->GetRatio();
-		CacheDisplayedBeat c = { seg->GetBeat(), displayedBeat, seg->GetRatio() };
-		pPlayerState->m_CacheDisplayedBeat.push_back( c );
-	}
+	pPlayerState->GetDisplayedTiming().PrepareDisplayedBeatLookup();
 
 	pPlayerState->m_CacheNoteStat.clear();
 
@@ -660,6 +654,7 @@ void Player::Load()
 	m_bTickHolds = GAMESTATE->GetCurrentGame()->m_bTickHolds;
 
 	m_LastTapNoteScore = TNS_None;
+	LogAudioClockStats();
 	// The editor can start playing in the middle of the song.
 	const int iNoteRow = BeatToNoteRowNotRounded( m_pPlayerState->m_Position.m_fSongBeat );
 	m_iFirstUncrossedRow     = iNoteRow - 1;
@@ -782,6 +777,17 @@ void Player::Load()
 	RageSoundLoadParams SoundParams;
 	SoundParams.m_bSupportPan = true;
 
+	// Decode everything that isn't loaded yet in parallel first, so each Load
+	// below just copies the shared preloaded sound.
+	std::vector<RString> vsKeysoundsToLoad;
+	for( unsigned i=0; i<m_vKeysounds.size(); i++ )
+	{
+		RString sKeysoundFilePath = sSongDir + pSong->m_vsKeysoundFile[i];
+		if( m_vKeysounds[i].GetLoadedFilePath() != sKeysoundFilePath )
+			vsKeysoundsToLoad.push_back( sKeysoundFilePath );
+	}
+	SOUNDMAN->PreloadSounds( vsKeysoundsToLoad );
+
 	float fBalance = GameSoundManager::GetPlayerBalance( pn );
 	for( unsigned i=0; i<m_vKeysounds.size(); i++ )
 	{
@@ -810,12 +816,15 @@ void Player::Load()
 
 	SAFE_DELETE( m_pIterUnjudgedMineRows );
 	m_pIterUnjudgedMineRows = new NoteData::all_tracks_iterator( m_NoteData.GetTapNoteRangeAllTracks(iNoteRow, MAX_NOTE_ROW ) );
+
+	m_viFirstUnjudgedRow.assign( m_NoteData.GetNumTracks(), 0 );
+	m_iFirstUnjudgedRowRevision = m_NoteData.GetRevision();
 }
 
 void Player::SendComboMessages( unsigned int iOldCombo, unsigned int iOldMissCombo )
 {
 	const unsigned int iCurCombo = m_pPlayerStageStats ? m_pPlayerStageStats->m_iCurCombo : 0;
-	if( iOldCombo > (unsigned int)COMBO_STOPPED_AT && iCurCombo < (unsigned int)COMBO_STOPPED_AT )
+	if( !IsReplaying() && iOldCombo > (unsigned int)COMBO_STOPPED_AT && iCurCombo < (unsigned int)COMBO_STOPPED_AT )
 	{
 		SCREENMAN->PostMessageToTopScreen( SM_ComboStopped, 0 );
 	}
@@ -863,9 +872,6 @@ void Player::Update( float fDeltaTime )
 			return;
 	}
 
-	const float fSongBeat = m_pPlayerState->m_Position.m_fSongBeat;
-	const int iSongRow = BeatToNoteRow( fSongBeat );
-
 	ArrowEffects::SetCurrentOptions(&m_pPlayerState->m_PlayerOptions.GetCurrent());
 
 	// Optimization: Don't spend time processing the things below that won't show
@@ -992,6 +998,46 @@ void Player::Update( float fDeltaTime )
 				m_pNoteField->SetPressed( col );
 	}
 
+	UpdateGameplayLogic( std::max(fDeltaTime - m_fLogicSecondsAhead, 0.0f), now );
+	m_fLogicSecondsAhead = 0;
+}
+
+void Player::UpdateLogicSubstep( float fDeltaTime, const RageTimer &tm )
+{
+	if( !m_bLoaded || GAMESTATE->m_pCurSong == nullptr || IsOniDead() || m_bPaused )
+		return;
+	// Multiplayer staggers its updates across frames; don't undo that here.
+	if( m_pPlayerState->m_mp != MultiPlayer_Invalid )
+		return;
+
+	m_fLogicSecondsAhead += fDeltaTime;
+	UpdateGameplayLogic( fDeltaTime, tm );
+}
+
+bool Player::IsTrackBeingPressed( int iTrack, const std::vector<GameInput> &GameI ) const
+{
+	if( m_pvReplayPressedSeconds != nullptr )
+		return (*m_pvReplayPressedSeconds)[iTrack] != -FLT_MAX;
+	return INPUTMAPPER->IsBeingPressed( GameI, m_pPlayerState->m_mp );
+}
+
+float Player::GetTrackSecsHeld( int iTrack, const GameInput &GameI ) const
+{
+	if( m_pvReplayPressedSeconds != nullptr )
+	{
+		const float fPressedSeconds = (*m_pvReplayPressedSeconds)[iTrack];
+		if( fPressedSeconds == -FLT_MAX )
+			return 0;
+		return (m_pPlayerState->m_Position.m_fMusicSeconds - fPressedSeconds) / GAMESTATE->m_SongOptions.GetCurrent().m_fMusicRate;
+	}
+	return INPUTMAPPER->GetSecsHeld( GameI, m_pPlayerState->m_mp );
+}
+
+/* Everything in Update() that judges notes, scores holds or changes life. */
+void Player::UpdateGameplayLogic( float fDeltaTime, const RageTimer &now )
+{
+	const int iSongRow = BeatToNoteRow( m_pPlayerState->m_Position.m_fSongBeat );
+
 	// handle Autoplay for rolls
 	if( m_pPlayerState->m_PlayerController != PC_HUMAN )
 	{
@@ -1045,7 +1091,7 @@ void Player::Update( float fDeltaTime )
 		// timing window. Let's find the cutoff point! (lastCheckRow)
 		const float rate = GAMESTATE->m_SongOptions.GetCurrent().m_fMusicRate;
 		const SongPosition songPosition = m_pPlayerState->m_Position;
-		const float musicPosition = songPosition.m_fMusicSeconds + (songPosition.m_LastBeatUpdate.Ago() * rate);
+		const float musicPosition = songPosition.m_fMusicSeconds + (SecondsSince(songPosition.m_LastBeatUpdate) * rate);
 		// We have to add 1 here, because GetBeatFromElapsedTime() can round down.
 		const int lastCheckRow = BeatToNoteRow(m_Timing->GetBeatFromElapsedTime(musicPosition + (largestWindow * rate)) + 1);
 
@@ -1088,7 +1134,7 @@ void Player::Update( float fDeltaTime )
 				std::vector<GameInput> input;
 				GAMESTATE->GetCurrentStyle(pn)->StyleInputToGameInput(track, pn, input);
 
-				tn.result.bHeld = INPUTMAPPER->IsBeingPressed(input, m_pPlayerState->m_mp);
+				tn.result.bHeld = IsTrackBeingPressed(track, input);
 			}
 		}
 	}
@@ -1365,7 +1411,7 @@ void Player::UpdateHoldNotes( int iSongRow, float fDeltaTime, std::vector<TrackR
 				std::vector<GameInput> GameI;
 				GAMESTATE->GetCurrentStyle(GetPlayerState()->m_PlayerNumber)->StyleInputToGameInput( iTrack, pn, GameI );
 
-				bIsHoldingButton &= INPUTMAPPER->IsBeingPressed(GameI, m_pPlayerState->m_mp);
+				bIsHoldingButton &= IsTrackBeingPressed(iTrack, GameI);
 			}
 		}
 	}
@@ -1880,11 +1926,44 @@ void Player::ChangeLifeRecord()
 		if( pn == PLAYER_2 )
 			fLife = 1.0f - fLife;
 	}
-	if( fLife != -1 )
+	if( fLife != -1 && !IsReplaying() )
 		if( m_pPlayerStageStats )
 			m_pPlayerStageStats->SetLifeRecordAt( fLife, STATSMAN->m_CurStageStats.m_fStepsSeconds );
 }
 
+bool Player::IsClosestNoteCandidate( int iRow, const TapNote &tn, bool bAllowGraded ) const
+{
+	if( !m_Timing->IsJudgableAtRow(iRow) )
+		return false;
+	// unsure if autoKeysounds should be excluded. -Wolfman2000
+	if( tn.type == TapNoteType_Empty || tn.type == TapNoteType_AutoKeysound )
+		return false;
+	if( !bAllowGraded && tn.result.tns != TNS_None )
+		return false;
+	return true;
+}
+
+/* Move the track's first unjudged row past any notes that have been graded
+ * since the last call, and return it.  Each note is only stepped over once,
+ * so jack streams don't make every press rescan the notes behind it. */
+int Player::AdvanceFirstUnjudgedRow( int col )
+{
+	if( m_iFirstUnjudgedRowRevision != m_NoteData.GetRevision() ||
+		m_viFirstUnjudgedRow.size() != std::size_t(m_NoteData.GetNumTracks()) )
+	{
+		m_viFirstUnjudgedRow.assign( m_NoteData.GetNumTracks(), 0 );
+		m_iFirstUnjudgedRowRevision = m_NoteData.GetRevision();
+	}
+
+	int &iFirstRow = m_viFirstUnjudgedRow[col];
+	NoteData::const_iterator begin, end;
+	m_NoteData.GetTapNoteRange( col, iFirstRow, MAX_NOTE_ROW, begin, end );
+	while( begin != end && !IsClosestNoteCandidate(begin->first, begin->second, false) )
+		++begin;
+	iFirstRow = begin == end ? MAX_NOTE_ROW : begin->first;
+	return iFirstRow;
+}
+
 int Player::GetClosestNoteDirectional( int col, int iStartRow, int iEndRow, bool bAllowGraded, bool bForward ) const
 {
 	NoteData::const_iterator begin, end;
@@ -1899,18 +1978,8 @@ int Player::GetClosestNoteDirectional( int col, int iStartRow, int iEndRow, bool
 			--begin;
 
 		// Is this the row we want?
-		do {
-			const TapNote &tn = begin->second;
-			if (!m_Timing->IsJudgableAtRow( begin->first ))
-				break;
-			// unsure if autoKeysounds should be excluded. -Wolfman2000
-			if( tn.type == TapNoteType_Empty || tn.type == TapNoteType_AutoKeysound )
-				break;
-			if( !bAllowGraded && tn.result.tns != TNS_None )
-				break;
-
+		if( IsClosestNoteCandidate(begin->first, begin->second, bAllowGraded) )
 			return begin->first;
-		} while(0);
 
 		if( bForward )
 			++begin;
@@ -1919,12 +1988,53 @@ int Player::GetClosestNoteDirectional( int col, int iStartRow, int iEndRow, bool
 	return -1;
 }
 
+/* Map an input timestamp to song time through the music's own position map,
+ * rather than extrapolating from the position sampled at the start of the
+ * frame.  Returns false if that isn't possible, and the caller should fall
+ * back on the frame position. */
+bool Player::GetMusicSecondsAtTime( const RageTimer &tm, float &fSecondsOut ) const
+{
+	if( !g_bJudgeFromAudioClock || m_pMusicClock == nullptr || !m_pMusicClock->IsPlaying() )
+		return false;
+
+	bool bApproximate;
+	RageTimer now;
+	const float fSeconds = m_pMusicClock->GetPositionSeconds( &bApproximate, &now );
+	if( bApproximate )
+		return false;
+
+	fSecondsOut = fSeconds - (now - tm) * m_pMusicClock->GetPlaybackRate();
+	return true;
+}
+
+void Player::LogAudioClockStats()
+{
+	if( m_iAudioClockSamples == 0 )
+		return;
+	LOG->Trace( "Player %d: %d steps judged from the audio clock, frame position was off by %.2fms on average, %.2fms at most",
+		m_pPlayerState ? m_pPlayerState->m_PlayerNumber+1 : 0, m_iAudioClockSamples,
+		m_fAudioClockErrorSum / m_iAudioClockSamples * 1000, m_fAudioClockErrorMax * 1000 );
+	m_iAudioClockSamples = 0;
+	m_fAudioClockErrorSum = 0;
+	m_fAudioClockErrorMax = 0;
+}
+
 // Find the closest note to fBeat.
-int Player::GetClosestNote( int col, int iNoteRow, int iMaxRowsAhead, int iMaxRowsBehind, bool bAllowGraded ) const
+int Player::GetClosestNote( int col, int iNoteRow, int iMaxRowsAhead, int iMaxRowsBehind, bool bAllowGraded )
 {
+	int iNextStart = iNoteRow;
+	int iPrevStart = iNoteRow-iMaxRowsBehind;
+	if( !bAllowGraded )
+	{
+		// Nothing before the first unjudged row can match.
+		const int iFirstUnjudgedRow = AdvanceFirstUnjudgedRow( col );
+		iNextStart = std::max( iNextStart, iFirstUnjudgedRow );
+		iPrevStart = std::max( iPrevStart, iFirstUnjudgedRow );
+	}
+
 	// Start at iIndexStartLookingAt and search outward.
-	int iNextIndex = GetClosestNoteDirectional( col, iNoteRow, iNoteRow+iMaxRowsAhead, bAllowGraded, true );
-	int iPrevIndex = GetClosestNoteDirectional( col, iNoteRow-iMaxRowsBehind, iNoteRow, bAllowGraded, false );
+	int iNextIndex = GetClosestNoteDirectional( col, iNextStart, iNoteRow+iMaxRowsAhead, bAllowGraded, true );
+	int iPrevIndex = GetClosestNoteDirectional( col, iPrevStart, iNoteRow, bAllowGraded, false );
 
 	if( iNextIndex == -1 && iPrevIndex == -1 )
 		return -1;
@@ -2013,8 +2123,11 @@ bool Player::IsOniDead() const
 
 void Player::DoTapScoreNone()
 {
-	Message msg( "ScoreNone" );
-	MESSAGEMAN->Broadcast( msg );
+	if( !IsReplaying() )
+	{
+		Message msg( "ScoreNone" );
+		MESSAGEMAN->Broadcast( msg );
+	}
 
 	const unsigned int iOldCombo = m_pPlayerStageStats ? m_pPlayerStageStats->m_iCurCombo : 0;
 	const unsigned int iOldMissCombo = m_pPlayerStageStats ? m_pPlayerStageStats->m_iCurMissCombo : 0;
@@ -2075,6 +2188,9 @@ void Player::ScoreAllActiveHoldsLetGo()
 
 void Player::PlayKeysound( const TapNote &tn, TapNoteScore score )
 {
+	if( IsReplaying() )
+		return;
+
 	// tap note must have keysound
 	if( tn.iKeysoundIndex >= 0 && tn.iKeysoundIndex < (int) m_vKeysounds.size() )
 	{
@@ -2111,9 +2227,15 @@ void Player::Step( int col, int row, const RageTimer &tm, bool bHeld, bool bRele
 
 	// Do everything that depends on a RageTimer here;
 	// set your breakpoints somewhere after this block.
-	const float fLastBeatUpdate = m_pPlayerState->m_Position.m_LastBeatUpdate.Ago();
-	const float fPositionSeconds = m_pPlayerState->m_Position.m_fMusicSeconds - tm.Ago();
-	const float fTimeSinceStep = tm.Ago();
+	const float fLastBeatUpdate = SecondsSince( m_pPlayerState->m_Position.m_LastBeatUpdate );
+	float fPositionSeconds = m_pPlayerState->m_Position.m_fMusicSeconds - SecondsSince( tm );
+	const float fTimeSinceStep = SecondsSince( tm );
+
+	// Where the music was when the step happened, according to the sound itself.
+	float fClockSeconds = 0;
+	const bool bFromAudioClock = row == -1 && GetMusicSecondsAtTime( tm, fClockSeconds );
+	if( bFromAudioClock )
+		fPositionSeconds = fClockSeconds;
 
 	float fSongBeat = m_pPlayerState->m_Position.m_fSongBeat;
 
@@ -2300,7 +2422,16 @@ void Player::Step( int col, int row, const RageTimer &tm, bool bHeld, bool bRele
 			const float fCurrentMusicSeconds = m_pPlayerState->m_Position.m_fMusicSeconds + (fLastBeatUpdate*GAMESTATE->m_SongOptions.GetCurrent().m_fMusicRate);
 
 			// ... which means it happened at this point in the music:
-			const float fMusicSeconds = fCurrentMusicSeconds - fTimeSinceStep * GAMESTATE->m_SongOptions.GetCurrent().m_fMusicRate;
+			float fMusicSeconds = fCurrentMusicSeconds - fTimeSinceStep * GAMESTATE->m_SongOptions.GetCurrent().m_fMusicRate;
+
+			if( bFromAudioClock )
+			{
+				const float fError = std::abs( fMusicSeconds - fClockSeconds );
+				++m_iAudioClockSamples;
+				m_fAudioClockErrorSum += fError;
+				m_fAudioClockErrorMax = std::max( m_fAudioClockErrorMax, fError );
+				fMusicSeconds = fClockSeconds;
+			}
 
 			// The offset from the actual step in seconds:
 			fNoteOffset = (fStepSeconds - fMusicSeconds) / GAMESTATE->m_SongOptions.GetCurrent().m_fMusicRate;	// account for music rate
@@ -2579,12 +2710,15 @@ void Player::Step( int col, int row, const RageTimer &tm, bool bHeld, bool bRele
 					// indicate "finalized" judgments. We handle that elsewhere so instead
 					// we introduce a new EarlyHitMessage to control the instant feedback
 					// we want to relay to to the player.					
-					Message msg( "EarlyHit" );
-					msg.SetParam( "Player", m_pPlayerState->m_PlayerNumber );
-					msg.SetParam( "TapNoteScore", score );
-					msg.SetParam( "Column", col );
-					msg.SetParam( "TapNoteOffset", -fNoteOffset);
-					MESSAGEMAN->Broadcast( msg );
+					if( m_bSendJudgmentAndComboMessages )
+					{
+						Message msg( "EarlyHit" );
+						msg.SetParam( "Player", m_pPlayerState->m_PlayerNumber );
+						msg.SetParam( "TapNoteScore", score );
+						msg.SetParam( "Column", col );
+						msg.SetParam( "TapNoteOffset", -fNoteOffset);
+						MESSAGEMAN->Broadcast( msg );
+					}
 				}
 			} else {
 				// If earlyTns is not set (good hit):
@@ -2655,7 +2789,8 @@ void Player::Step( int col, int row, const RageTimer &tm, bool bHeld, bool bRele
 		}
 	}
 	// XXX:
-	if( !bRelease )
+	// Replays run outside of gameplay, so don't let the theme react to them.
+	if( !bRelease && !IsReplaying() )
 	{
 		if( m_pNoteField )
 		{
@@ -2872,6 +3007,8 @@ void Player::UpdateJudgedRows()
 
 		for (RageSound *sound : setSounds)
 		{
+			if( IsReplaying() )
+				break;
 			// Only play one copy of each mine sound at a time per player.
 			sound->Stop();
 			sound->Play(false);
@@ -2931,7 +3068,7 @@ void Player::CrossedRows( int iLastRowCrossed, const RageTimer &now )
 					{
 						for(std::size_t i= 0; i < GameI.size(); ++i)
 						{
-							float fSecsHeld = INPUTMAPPER->GetSecsHeld(GameI[i], m_pPlayerState->m_mp);
+							float fSecsHeld = GetTrackSecsHeld(iTrack, GameI[i]);
 							if(fSecsHeld >= PREFSMAN->m_fPadStickSeconds)
 							{
 								Step(iTrack, -1, now - PREFSMAN->m_fPadStickSeconds, true, false);
@@ -2940,7 +3077,7 @@ void Player::CrossedRows( int iLastRowCrossed, const RageTimer &now )
 					}
 					else
 					{
-						if(INPUTMAPPER->IsBeingPressed(GameI, m_pPlayerState->m_mp))
+						if(IsTrackBeingPressed(iTrack, GameI))
 						{
 							Step(iTrack, -1, now, true, false);
 						}
@@ -2959,14 +3096,14 @@ void Player::CrossedRows( int iLastRowCrossed, const RageTimer &now )
 				{
 					for(std::size_t i= 0; i < GameI.size(); ++i)
 					{
-						float fSecsHeld = INPUTMAPPER->GetSecsHeld(GameI[i], m_pPlayerState->m_mp);
+						float fSecsHeld = GetTrackSecsHeld(iTrack, GameI[i]);
 						if(fSecsHeld >= PREFSMAN->m_fPadStickSeconds)
 						{
 							Step( iTrack, -1, now - PREFSMAN->m_fPadStickSeconds, true, false );
 						}
 					}
 				}
-				else if(INPUTMAPPER->IsBeingPressed(GameI, m_pPlayerState->m_mp))
+				else if(IsTrackBeingPressed(iTrack, GameI))
 				{
 					Step( iTrack, iRow, now, true, false );
 				}
@@ -3130,29 +3267,33 @@ void Player::HandleTapRowScore( unsigned row )
 		SetCombo( iCurCombo, iCurMissCombo );
 	}
 
+	// Replays run outside of gameplay, so don't tell the screen about them.
+	if( !IsReplaying() )
+	{
 #define CROSSED( x ) (iOldCombo<x && iCurCombo>=x)
-	if ( CROSSED(100) )
-		SCREENMAN->PostMessageToTopScreen( SM_100Combo, 0 );
-	else if( CROSSED(200) )
-		SCREENMAN->PostMessageToTopScreen( SM_200Combo, 0 );
-	else if( CROSSED(300) )
-		SCREENMAN->PostMessageToTopScreen( SM_300Combo, 0 );
-	else if( CROSSED(400) )
-		SCREENMAN->PostMessageToTopScreen( SM_400Combo, 0 );
-	else if( CROSSED(500) )
-		SCREENMAN->PostMessageToTopScreen( SM_500Combo, 0 );
-	else if( CROSSED(600) )
-		SCREENMAN->PostMessageToTopScreen( SM_600Combo, 0 );
-	else if( CROSSED(700) )
-		SCREENMAN->PostMessageToTopScreen( SM_700Combo, 0 );
-	else if( CROSSED(800) )
-		SCREENMAN->PostMessageToTopScreen( SM_800Combo, 0 );
-	else if( CROSSED(900) )
-		SCREENMAN->PostMessageToTopScreen( SM_900Combo, 0 );
-	else if( CROSSED(1000))
-		SCREENMAN->PostMessageToTopScreen( SM_1000Combo, 0 );
-	else if( (iOldCombo / 100) < (iCurCombo / 100) && iCurCombo > 1000 )
-		SCREENMAN->PostMessageToTopScreen( SM_ComboContinuing, 0 );
+		if ( CROSSED(100) )
+			SCREENMAN->PostMessageToTopScreen( SM_100Combo, 0 );
+		else if( CROSSED(200) )
+			SCREENMAN->PostMessageToTopScreen( SM_200Combo, 0 );
+		else if( CROSSED(300) )
+			SCREENMAN->PostMessageToTopScreen( SM_300Combo, 0 );
+		else if( CROSSED(400) )
+			SCREENMAN->PostMessageToTopScreen( SM_400Combo, 0 );
+		else if( CROSSED(500) )
+			SCREENMAN->PostMessageToTopScreen( SM_500Combo, 0 );
+		else if( CROSSED(600) )
+			SCREENMAN->PostMessageToTopScreen( SM_600Combo, 0 );
+		else if( CROSSED(700) )
+			SCREENMAN->PostMessageToTopScreen( SM_700Combo, 0 );
+		else if( CROSSED(800) )
+			SCREENMAN->PostMessageToTopScreen( SM_800Combo, 0 );
+		else if( CROSSED(900) )
+			SCREENMAN->PostMessageToTopScreen( SM_900Combo, 0 );
+		else if( CROSSED(1000))
+			SCREENMAN->PostMessageToTopScreen( SM_1000Combo, 0 );
+		else if( (iOldCombo / 100) < (iCurCombo / 100) && iCurCombo > 1000 )
+			SCREENMAN->PostMessageToTopScreen( SM_ComboContinuing, 0 );
+	}
 #undef CROSSED
 
 	// new max combo
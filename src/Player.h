@@ -116,6 +116,19 @@ public:
 	TapNoteScore GetLastTapNoteScore() const { return m_LastTapNoteScore; }
 	void ApplyWaitingTransforms();
 	void SetPaused( bool bPaused ) { m_bPaused = bPaused; }
+	/* The sound whose position defines song time.  With JudgeFromAudioClock
+	 * enabled, step offsets are measured against it directly. */
+	void SetMusicClock( const RageSound *pMusic ) { m_pMusicClock = pMusic; }
+	/* Run judgment, hold and life logic for a song position between frames.
+	 * The next Update() only covers the time not already handled here. */
+	void UpdateLogicSubstep( float fDeltaTime, const RageTimer &tm );
+	/* For replays: the song second each track was pressed at, or -FLT_MAX if
+	 * it's up.  When set, this is used instead of INPUTMAPPER to
+	 * decide whether holds are being held. */
+	void SetReplayHeldState( const std::vector<float> *pvPressedSeconds ) { m_pvReplayPressedSeconds = pvPressedSeconds; }
+	/* For replays: the time the current tick is processed at.  Judgments
+	 * measure against this instead of the real clock. */
+	void SetReplayNow( const RageTimer &tm ) { m_ReplayNow = tm; }
 
 	static float GetMaxStepDistanceSeconds();
 	static float GetWindowSeconds( TimingWindow tw );
@@ -142,6 +155,11 @@ public:
 	bool m_inside_lua_set_life;
 
 protected:
+	void UpdateGameplayLogic( float fDeltaTime, const RageTimer &now );
+	bool IsReplaying() const { return m_pvReplayPressedSeconds != nullptr; }
+	bool IsTrackBeingPressed( int iTrack, const std::vector<GameInput> &GameI ) const;
+	float GetTrackSecsHeld( int iTrack, const GameInput &GameI ) const;
+	float SecondsSince( const RageTimer &tm ) const { return IsReplaying()? m_ReplayNow - tm : tm.Ago(); }
 	void UpdateTapNotesMissedOlderThan( float fMissIfOlderThanThisBeat );
 	void UpdateJudgedRows();
 	void FlashGhostRow( int iRow );
@@ -166,8 +184,12 @@ protected:
 	void ChangeLife( HoldNoteScore hns, TapNoteScore tns );
 	void ChangeLifeRecord();
 
+	bool IsClosestNoteCandidate( int iRow, const TapNote &tn, bool bAllowGraded ) const;
+	int AdvanceFirstUnjudgedRow( int col );
 	int GetClosestNoteDirectional( int col, int iStartRow, int iMaxRowsAhead, bool bAllowGraded, bool bForward ) const;
-	int GetClosestNote( int col, int iNoteRow, int iMaxRowsAhead, int iMaxRowsBehind, bool bAllowGraded ) const;
+	int GetClosestNote( int col, int iNoteRow, int iMaxRowsAhead, int iMaxRowsBehind, bool bAllowGraded );
+	bool GetMusicSecondsAtTime( const RageTimer &tm, float &fSecondsOut ) const;
+	void LogAudioClockStats();
 	int GetClosestNonEmptyRowDirectional( int iStartRow, int iMaxRowsAhead, bool bAllowGraded, bool bForward ) const;
 	int GetClosestNonEmptyRow( int iNoteRow, int iMaxRowsAhead, int iMaxRowsBehind, bool bAllowGraded ) const;
 
@@ -188,6 +210,15 @@ protected:
 	PlayerStageStats	*m_pPlayerStageStats;
 	TimingData      *m_Timing;
 	float			m_fNoteFieldHeight;
+	float			m_fLogicSecondsAhead;
+	const RageSound		*m_pMusicClock;
+	const std::vector<float>	*m_pvReplayPressedSeconds;
+	RageTimer		m_ReplayNow;
+	/* How far the frame-extrapolated song position was from the audio clock
+	 * for the steps judged since Load(). */
+	int			m_iAudioClockSamples;
+	float			m_fAudioClockErrorSum;
+	float			m_fAudioClockErrorMax;
 
 	bool			m_bPaused;
 	bool			m_bDelay;
@@ -219,6 +250,11 @@ protected:
 	NoteData::all_tracks_iterator *m_pIterUncrossedRows;
 	NoteData::all_tracks_iterator *m_pIterUnjudgedRows;
 	NoteData::all_tracks_iterator *m_pIterUnjudgedMineRows;
+	/* For each track, the first row that may still hold a note to step on.
+	 * Everything before it has been graded, so GetClosestNote doesn't need to
+	 * walk back over it.  Rebuilt if m_NoteData changes. */
+	std::vector<int>	m_viFirstUnjudgedRow;
+	unsigned		m_iFirstUnjudgedRowRevision;
 	unsigned int	m_iLastSeenCombo;
 	bool	m_bSeenComboYet;
 	JudgedRows		*m_pJudgedRows;
@@ -128,13 +128,7 @@ void PlayerStageStats::AddStats( const PlayerStageStats& other )
 	const float fOtherLastSecond = other.m_fLastSecond + m_fLastSecond + 1.0f;
 	m_fLastSecond = fOtherLastSecond;
 
-	std::map<float, float>::const_iterator it;
-	for( it = other.m_fLifeRecord.begin(); it != other.m_fLifeRecord.end(); ++it )
-	{
-		const float pos = it->first;
-		const float life = it->second;
-		m_fLifeRecord[fOtherFirstSecond+pos] = life;
-	}
+	m_LifeRecord.Append( other.m_LifeRecord, fOtherFirstSecond );
 
 	for( unsigned i=0; i<other.m_ComboList.size(); ++i )
 	{
@@ -436,91 +430,22 @@ void PlayerStageStats::SetLifeRecordAt( float fLife, float fStepsSecond )
 	m_fLastSecond = std::max( fStepsSecond, m_fLastSecond );
 	//LOG->Trace( "fLastSecond = %f", m_fLastSecond );
 
-	// fStepsSecond will usually be greater than any value already in the map,
-	// but if a tap and a hold both set the life on the same frame, it won't.
-	// Check whether an entry already exists for the current time, and move it
-	// back a tiny bit if it does and the new value is not the same as the old.
-	// Otherwise, you get the rare bug where the life graph shows a gradual
-	// decline when the lifebar was actually full up to a miss.  This occurs
-	// because the first call has full life, and removes the previous full life
-	// entry.  Then the second call of the frame occurs and sets the life for
-	// the current time to a lower value.
-	// -Kyz
-	std::map<float, float>::iterator curr= m_fLifeRecord.find(fStepsSecond);
-	if(curr != m_fLifeRecord.end())
-	{
-		if(curr->second != fLife)
-		{
-			// 2^-8
-			m_fLifeRecord[fStepsSecond - 0.00390625]= curr->second;
-		}
-	}
-	m_fLifeRecord[fStepsSecond] = fLife;
+	m_LifeRecord.Set( fStepsSecond, fLife );
 
 	Message msg(static_cast<MessageID>(Message_LifeMeterChangedP1+Enum::to_integral(m_player_number)));
 	msg.SetParam("Life", fLife);
 	msg.SetParam("StepsSecond", fStepsSecond);
 	MESSAGEMAN->Broadcast(msg);
-
-	// Memory optimization:
-	// If we have three consecutive records A, B, and C all with the same fLife,
-	// we can eliminate record B without losing data. Only check the last three
-	// records in the map since we're only inserting at the end, and we know all
-	// earlier redundant records have already been removed.
-	std::map<float, float>::iterator C = m_fLifeRecord.end();
-	--C;
-	if( C == m_fLifeRecord.begin() ) // no earlier records left
-		return;
-
-	std::map<float, float>::iterator B = C;
-	--B;
-	if( B == m_fLifeRecord.begin() ) // no earlier records left
-		return;
-
-	std::map<float, float>::iterator A = B;
-	--A;
-
-	if( A->second == B->second && B->second == C->second )
-		m_fLifeRecord.erase(B);
 }
 
 float PlayerStageStats::GetLifeRecordAt( float fStepsSecond ) const
 {
-	if( m_fLifeRecord.empty() )
-		return 0;
-
-	// Find the first element whose key is greater than k.
-	std::map<float, float>::const_iterator it = m_fLifeRecord.upper_bound( fStepsSecond );
-
-	// Find the last element whose key is less than or equal to k.
-	if( it != m_fLifeRecord.begin() )
-		--it;
-
-	return it->second;
-
+	return m_LifeRecord.GetAt( fStepsSecond );
 }
 
 float PlayerStageStats::GetLifeRecordLerpAt( float fStepsSecond ) const
 {
-	if( m_fLifeRecord.empty() )
-		return 0;
-
-	// Find the first element whose key is greater than k.
-	std::map<float, float>::const_iterator later = m_fLifeRecord.upper_bound( fStepsSecond );
-
-	// Find the last element whose key is less than or equal to k.
-	std::map<float, float>::const_iterator earlier = later;
-	if( earlier != m_fLifeRecord.begin() )
-		--earlier;
-
-	if( later == m_fLifeRecord.end() )
-		return earlier->second;
-
-	if( earlier->first == later->first ) // two samples from the same time.  Don't divide by zero in SCALE
-		return earlier->second;
-
-	// earlier <= pos <= later
-	return SCALE( fStepsSecond, earlier->first, later->first, earlier->second, later->second );
+	return m_LifeRecord.GetLerpAt( fStepsSecond );
 }
 
 void PlayerStageStats::GetLifeRecord( float *fLifeOut, int iNumSamples, float fStepsEndSecond ) const
@@ -534,11 +459,7 @@ void PlayerStageStats::GetLifeRecord( float *fLifeOut, int iNumSamples, float fS
 
 float PlayerStageStats::GetCurrentLife() const
 {
-	if( m_fLifeRecord.empty() )
-		return 0;
-	std::map<float, float>::const_iterator iter = m_fLifeRecord.end();
-	--iter;
-	return iter->second;
+	return m_LifeRecord.GetLast();
 }
 
 /* If bRollover is true, we're being called before gameplay begins, so we can
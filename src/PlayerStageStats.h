@@ -5,6 +5,7 @@
 #include "RadarValues.h"
 #include "HighScore.h"
 #include "PlayerNumber.h"
+#include "LifeRecord.h"
 
 #include <map>
 #include <vector>
@@ -104,7 +105,7 @@ public:
 	float		m_iNumControllerSteps;
 	float		m_fCaloriesBurned;
 
-	std::map<float,float> m_fLifeRecord;
+	LifeRecord m_LifeRecord;
 	void	SetLifeRecordAt( float fLife, float fStepsSecond );
 	void	GetLifeRecord( float *fLifeOut, int iNumSamples, float fStepsEndSecond ) const;
 	float	GetLifeRecordAt( float fStepsSecond ) const;
@@ -16,12 +16,6 @@
 
 struct lua_State;
 
-struct CacheDisplayedBeat {
-	float beat;
-	float displayedBeat;
-	float velocity;
-};
-
 struct CacheNoteStat {
 	float beat;
 	int notesLower;
@@ -67,15 +61,6 @@ public:
 	const SongPosition &GetDisplayedPosition() const;
 	const TimingData   &GetDisplayedTiming()   const;
 
-	/**
-	 * @brief Holds a vector sorted by real beat, the beat that would be displayed
-	 *        in the NoteField (because they are affected by scroll segments), and
-	 *        also the velocity.
-	 *        This vector will be populated on Player::Load() be used a lot in
-	 *        ArrowEffects to determine the target beat in O(log N).
-	 */
-	std::vector<CacheDisplayedBeat> m_CacheDisplayedBeat;
-
 	/**
 	 * @brief Holds a vector sorted by beat, the cumulative number of notes from
 	 *        the start of the song. This will be used by [insert more description here]
@@ -312,6 +312,7 @@ public:
 	Preference<RString>	m_iSoundDevice;
 	Preference<int> m_iRageSoundSampleCountClamp;
 	Preference<int>	m_iSoundPreferredSampleRate;
+	Preference<bool>	m_bSoundLowLatency;
 	Preference<RString>	m_sLightsStepsDifficulty;
 	Preference<bool>	m_bLightsSimplifyBass;
 	Preference<bool>	m_bAllowUnacceleratedRenderer;
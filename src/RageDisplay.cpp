@@ -18,6 +18,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <vector>
 
 
@@ -438,6 +439,13 @@ static MatrixStack g_ViewStack;
 static MatrixStack g_WorldStack;
 static MatrixStack g_TextureStack;
 
+static bool g_bBatchingQuads = false;
+static std::vector<RageSpriteVertex> g_vQuadBatch;
+// The camera that the batched quads were collected under.
+static RageMatrix g_QuadBatchCentering;
+static RageMatrix g_QuadBatchProjection;
+static RageMatrix g_QuadBatchView;
+
 
 RageDisplay::RageDisplay()
 {
@@ -553,6 +561,38 @@ void RageDisplay::LoadIdentity()
 	g_WorldStack.LoadIdentity();
 }
 
+bool RageDisplay::IsRectOffScreen( const RectF &rect ) const
+{
+	// Take the corners into clip space the same way the renderer does.  If
+	// they're all past the same edge, so is everything between them.
+	RageMatrix mat;
+	RageMatrixMultiply( &mat, GetCentering(), GetProjectionTop() );
+	RageMatrixMultiply( &mat, &mat, GetViewTop() );
+	RageMatrixMultiply( &mat, &mat, GetWorldTop() );
+
+	const RageVector4 corners[4] = {
+		RageVector4( rect.left, rect.top, 0, 1 ),
+		RageVector4( rect.right, rect.top, 0, 1 ),
+		RageVector4( rect.left, rect.bottom, 0, 1 ),
+		RageVector4( rect.right, rect.bottom, 0, 1 ),
+	};
+	int iLeft = 0, iRight = 0, iBelow = 0, iAbove = 0;
+	for( const RageVector4 &corner : corners )
+	{
+		RageVector4 v;
+		RageVec4TransformCoord( &v, &corner, &mat );
+		if( v.x < -v.w )
+			++iLeft;
+		if( v.x > v.w )
+			++iRight;
+		if( v.y < -v.w )
+			++iBelow;
+		if( v.y > v.w )
+			++iAbove;
+	}
+	return iLeft == 4 || iRight == 4 || iBelow == 4 || iAbove == 4;
+}
+
 
 void RageDisplay::TexturePushMatrix()
 {
@@ -842,11 +882,100 @@ void RageDisplay::DrawQuads( const RageSpriteVertex v[], int iNumVerts )
 	if(!iNumVerts)
 		return;
 
+	if( g_bBatchingQuads )
+	{
+		AddToQuadBatch( v, iNumVerts );
+		return;
+	}
+
 	this->DrawQuadsInternal(v,iNumVerts);
 
 	StatsAddVerts(iNumVerts);
 }
 
+void RageDisplay::BeginQuadBatch()
+{
+	ASSERT( !g_bBatchingQuads );
+	g_bBatchingQuads = true;
+}
+
+void RageDisplay::EndQuadBatch()
+{
+	ASSERT( g_bBatchingQuads );
+	FlushQuadBatch();
+	g_bBatchingQuads = false;
+}
+
+static bool MatricesEqual( const RageMatrix &a, const RageMatrix &b )
+{
+	return std::memcmp( &a, &b, sizeof(RageMatrix) ) == 0;
+}
+
+void RageDisplay::AddToQuadBatch( const RageSpriteVertex v[], int iNumVerts )
+{
+	// Quads seen through a different camera can't be drawn together.
+	if( !g_vQuadBatch.empty() &&
+		(!MatricesEqual(g_QuadBatchCentering, g_CenteringMatrix) ||
+		 !MatricesEqual(g_QuadBatchProjection, *GetProjectionTop()) ||
+		 !MatricesEqual(g_QuadBatchView, *GetViewTop())) )
+	{
+		FlushQuadBatch();
+	}
+	if( g_vQuadBatch.empty() )
+	{
+		g_QuadBatchCentering = g_CenteringMatrix;
+		g_QuadBatchProjection = *GetProjectionTop();
+		g_QuadBatchView = *GetViewTop();
+	}
+
+	const RageMatrix *pWorld = GetWorldTop();
+	const RageMatrix *pTexture = GetTextureTop();
+	const std::size_t iStart = g_vQuadBatch.size();
+	g_vQuadBatch.insert( g_vQuadBatch.end(), v, v+iNumVerts );
+	for( std::size_t i = iStart; i < g_vQuadBatch.size(); ++i )
+	{
+		RageSpriteVertex &vert = g_vQuadBatch[i];
+		RageVec3TransformCoord( &vert.p, &vert.p, pWorld );
+		RageVec3TransformNormal( &vert.n, &vert.n, pWorld );
+		RageVector3 t( vert.t.x, vert.t.y, 0 );
+		RageVec3TransformCoord( &t, &t, pTexture );
+		vert.t = RageVector2( t.x, t.y );
+	}
+}
+
+void RageDisplay::FlushQuadBatch()
+{
+	if( g_vQuadBatch.empty() )
+		return;
+
+	// The quads are already in world space, with their texture coordinates
+	// transformed, so draw them with only the camera they were collected under.
+	RageMatrix identity;
+	RageMatrixIdentity( &identity );
+	const RageMatrix centering = g_CenteringMatrix;
+	g_CenteringMatrix = g_QuadBatchCentering;
+	g_ProjectionStack.Push();
+	g_ProjectionStack.SetTop( g_QuadBatchProjection );
+	g_ViewStack.Push();
+	g_ViewStack.SetTop( g_QuadBatchView );
+	g_WorldStack.Push();
+	g_WorldStack.SetTop( identity );
+	g_TextureStack.Push();
+	g_TextureStack.SetTop( identity );
+
+	const int iNumVerts = g_vQuadBatch.size();
+	this->DrawQuadsInternal( g_vQuadBatch.data(), iNumVerts );
+	StatsAddVerts( iNumVerts );
+
+	g_TextureStack.Pop();
+	g_WorldStack.Pop();
+	g_ViewStack.Pop();
+	g_ProjectionStack.Pop();
+	g_CenteringMatrix = centering;
+
+	g_vQuadBatch.clear();
+}
+
 void RageDisplay::DrawQuadStrip( const RageSpriteVertex v[], int iNumVerts )
 {
 	ASSERT( (iNumVerts%2) == 0 );
@@ -854,6 +983,7 @@ void RageDisplay::DrawQuadStrip( const RageSpriteVertex v[], int iNumVerts )
 	if(iNumVerts < 4)
 		return;
 
+	FlushQuadBatch();
 	this->DrawQuadStripInternal(v,iNumVerts);
 
 	StatsAddVerts(iNumVerts);
@@ -863,6 +993,7 @@ void RageDisplay::DrawFan( const RageSpriteVertex v[], int iNumVerts )
 {
 	ASSERT( iNumVerts >= 3 );
 
+	FlushQuadBatch();
 	this->DrawFanInternal(v,iNumVerts);
 
 	StatsAddVerts(iNumVerts);
@@ -872,6 +1003,7 @@ void RageDisplay::DrawStrip( const RageSpriteVertex v[], int iNumVerts )
 {
 	ASSERT( iNumVerts >= 3 );
 
+	FlushQuadBatch();
 	this->DrawStripInternal(v,iNumVerts);
 
 	StatsAddVerts(iNumVerts);
@@ -884,6 +1016,7 @@ void RageDisplay::DrawTriangles( const RageSpriteVertex v[], int iNumVerts )
 
 	ASSERT( iNumVerts >= 3 );
 
+	FlushQuadBatch();
 	this->DrawTrianglesInternal(v,iNumVerts);
 
 	StatsAddVerts(iNumVerts);
@@ -891,6 +1024,7 @@ void RageDisplay::DrawTriangles( const RageSpriteVertex v[], int iNumVerts )
 
 void RageDisplay::DrawCompiledGeometry( const RageCompiledGeometry *p, int iMeshIndex, const std::vector<msMesh> &vMeshes )
 {
+	FlushQuadBatch();
 	this->DrawCompiledGeometryInternal( p, iMeshIndex );
 
 	StatsAddVerts( vMeshes[iMeshIndex].Triangles.size() );
@@ -900,6 +1034,7 @@ void RageDisplay::DrawLineStrip( const RageSpriteVertex v[], int iNumVerts, floa
 {
 	ASSERT( iNumVerts >= 2 );
 
+	FlushQuadBatch();
 	this->DrawLineStripInternal( v, iNumVerts, LineWidth );
 }
 
@@ -922,6 +1057,7 @@ void RageDisplay::DrawSymmetricQuadStrip( const RageSpriteVertex v[], int iNumVe
 	if( iNumVerts < 6 )
 		return;
 
+	FlushQuadBatch();
 	this->DrawSymmetricQuadStripInternal( v, iNumVerts );
 
 	StatsAddVerts( iNumVerts );
@@ -929,6 +1065,7 @@ void RageDisplay::DrawSymmetricQuadStrip( const RageSpriteVertex v[], int iNumVe
 
 void RageDisplay::DrawCircle( const RageSpriteVertex &v, float radius )
 {
+	FlushQuadBatch();
 	this->DrawCircleInternal( v, radius );
 }
 
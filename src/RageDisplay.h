@@ -349,6 +349,15 @@ public:
 
 	void DrawQuad( const RageSpriteVertex v[] ) { DrawQuads(v,4); } /* alias. upper-left, upper-right, lower-left, lower-right */
 
+	/* Between BeginQuadBatch and EndQuadBatch, DrawQuads only collects quads,
+	 * moved into world space and with the texture matrix applied to their
+	 * coordinates, and they're all drawn together with one call.  This is for
+	 * drawing many copies of one simple actor, like the notes in a column.
+	 * The quads are drawn with the render state that's current when the batch
+	 * ends, so nothing but the matrices may change in between. */
+	void BeginQuadBatch();
+	void EndQuadBatch();
+
 	// hacks for cell-shaded models
 	virtual void SetPolygonMode( PolygonMode ) {}
 	virtual void SetLineWidth( float ) {}
@@ -384,6 +393,9 @@ protected:
 
 	void DrawPolyLine( const RageSpriteVertex &p1, const RageSpriteVertex &p2, float LineWidth );
 
+	void AddToQuadBatch( const RageSpriteVertex v[], int iNumVerts );
+	void FlushQuadBatch();
+
 	// Stuff in RageDisplay.cpp
 	void SetDefaultRenderStates();
 
@@ -412,6 +424,9 @@ public:
 	void PostMultMatrix( const RageMatrix &f );
 	void PreMultMatrix( const RageMatrix &f );
 	void LoadIdentity();
+	/* Would a rectangle at z = 0 in the current world space be drawn entirely
+	 * outside the viewport? */
+	bool IsRectOffScreen( const RectF &rect ) const;
 
 	// Texture matrix functions
 	void TexturePushMatrix();
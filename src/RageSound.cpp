@@ -216,6 +216,29 @@ bool RageSound::Load( RString sSoundFilePath, bool bPrecache, const RageSoundLoa
 		bNeedBuffer = false;
 	}
 
+	AddFilters( sSoundFilePath, bNeedBuffer, pParams );
+	return true;
+}
+
+bool RageSound::LoadDecoded( RString sSoundFilePath, RageSoundReader *pSound, const RageSoundLoadParams *pParams )
+{
+	LOG->Trace( "RageSound: Load \"%s\" (from decoded reader)", sSoundFilePath.c_str() );
+
+	if( pParams == nullptr )
+	{
+		static const RageSoundLoadParams Defaults;
+		pParams = &Defaults;
+	}
+
+	LoadSoundReader( pSound );
+
+	/* The reader is already decoded into memory, so reads don't need buffering. */
+	AddFilters( sSoundFilePath, false, pParams );
+	return true;
+}
+
+void RageSound::AddFilters( const RString &sSoundFilePath, bool bNeedBuffer, const RageSoundLoadParams *pParams )
+{
 	m_pSource = new RageSoundReader_Extend( m_pSource );
 	if( bNeedBuffer )
 		m_pSource = new RageSoundReader_ThreadedBuffer( m_pSource );
@@ -233,8 +256,6 @@ bool RageSound::Load( RString sSoundFilePath, bool bPrecache, const RageSoundLoa
 	m_sFilePath = sSoundFilePath;
 
 	m_Mutex.SetName( ssprintf("RageSound (%s)", Basename(sSoundFilePath).c_str() ) );
-
-	return true;
 }
 
 void RageSound::LoadSoundReader( RageSoundReader *pSound )
@@ -106,6 +106,11 @@ public:
 	 * this always will not cache the sound; this may become a preference. */
 	bool Load( RString sFile );
 
+	/* Load a reader that was already opened for sFile, such as a cached decoded
+	 * segment.  This sets up the same filters as Load(), but never buffers or
+	 * precaches, since the data is already in memory.  Takes ownership of pSound. */
+	bool LoadDecoded( RString sFile, RageSoundReader *pSound, const RageSoundLoadParams *pParams = nullptr );
+
 	/* Load a RageSoundReader that you've set up yourself. Sample rate conversion
 	 * will be set up only if needed. Doesn't fail. */
 	void LoadSoundReader( RageSoundReader *pSound );
@@ -157,6 +162,7 @@ private:
 	RString m_sFilePath;
 
 	void ApplyParams();
+	void AddFilters( const RString &sSoundFilePath, bool bNeedBuffer, const RageSoundLoadParams *pParams );
 	RageSoundParams m_Param;
 
 	/* Current position of the output sound, in frames. If < 0, nothing will play
@@ -15,13 +15,18 @@
 #include "RageLog.h"
 #include "RageTimer.h"
 #include "RageSoundReader_Preload.h"
+#include "RageSoundReader_FileReader.h"
+#include "RageSoundReader_Resample_Good.h"
 #include "LocalizedString.h"
 #include "Preference.h"
 #include "RageSoundReader_PostBuffering.h"
 
 #include "arch/Sound/RageSoundDriver.h"
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <thread>
 
 /*
  * The lock ordering requirements are:
@@ -35,6 +40,9 @@
 static RageMutex g_SoundManMutex("SoundMan");
 static Preference<RString> g_sSoundDrivers( "SoundDrivers", "" ); // "" == DEFAULT_SOUND_DRIVER_LIST
 
+/* The number of threads PreloadSounds decodes with.  0 uses one per CPU. */
+static Preference<int> g_iSoundPreloadThreads( "SoundPreloadThreads", 0 );
+
 RageSoundManager *SOUNDMAN = nullptr;
 
 RageSoundManager::RageSoundManager(): m_pDriver(nullptr),
@@ -183,6 +191,121 @@ void RageSoundManager::AddLoadedSound( const RString &sPath_, RageSoundReader_Pr
 	m_mapPreloadedSounds[sPath] = pSound->Copy();
 }
 
+namespace
+{
+	struct PreloadJob
+	{
+		std::vector<RString> m_vsPaths;
+		std::vector<RageSoundReader_Preload *> m_vpResults;
+		std::atomic<unsigned> m_iNext;
+		int m_iSampleRate;
+	};
+
+	/* Open and decode one sound the same way RageSound::Load( sPath, true ) does,
+	 * so the result can be shared with it: resampled to the driver rate, then
+	 * preloaded.  Return nullptr if it can't be opened or is too big to preload. */
+	RageSoundReader_Preload *PreloadOneSound( const RString &sPath, int iSampleRate )
+	{
+		RString sError;
+		RageSoundReader *pSound = RageSoundReader_FileReader::OpenFile( sPath, sError );
+		if( pSound == nullptr )
+			return nullptr; // RageSound::Load will report the error
+
+		if( pSound->GetSampleRate() != iSampleRate )
+			pSound = new RageSoundReader_Resample_Good( pSound, iSampleRate );
+
+		if( !RageSoundReader_Preload::PreloadSound(pSound) )
+		{
+			delete pSound;
+			return nullptr;
+		}
+		return static_cast<RageSoundReader_Preload *>( pSound );
+	}
+
+	/* Each thread takes the next path until they're all done.  The results are
+	 * only touched by the thread that decoded them until the job is finished. */
+	int PreloadThread( void *p )
+	{
+		PreloadJob *pJob = static_cast<PreloadJob *>( p );
+		for(;;)
+		{
+			const unsigned i = pJob->m_iNext++;
+			if( i >= pJob->m_vsPaths.size() )
+				return 0;
+			pJob->m_vpResults[i] = PreloadOneSound( pJob->m_vsPaths[i], pJob->m_iSampleRate );
+		}
+	}
+}
+
+void RageSoundManager::PreloadSounds( const std::vector<RString> &vsPaths )
+{
+	PreloadJob job;
+	job.m_iNext = 0;
+	job.m_iSampleRate = GetDriverSampleRate();
+
+	/* Skip sounds we already have, and duplicates in the list. */
+	{
+		LockMut( g_SoundManMutex );
+		std::set<RString> setSeen;
+		for( RString sPath : vsPaths )
+		{
+			sPath.MakeLower();
+			if( m_mapPreloadedSounds.find(sPath) != m_mapPreloadedSounds.end() )
+				continue;
+			if( setSeen.insert(sPath).second )
+				job.m_vsPaths.push_back( sPath );
+		}
+	}
+	if( job.m_vsPaths.empty() )
+		return;
+	job.m_vpResults.resize( job.m_vsPaths.size(), nullptr );
+
+	int iThreads = g_iSoundPreloadThreads;
+	if( iThreads <= 0 )
+		iThreads = std::max( (int) std::thread::hardware_concurrency(), 1 );
+	iThreads = std::min( iThreads, (int) job.m_vsPaths.size() );
+
+	const RageTimer tStart;
+
+	/* This thread works on the job too, so start one less than we want. */
+	std::vector<std::unique_ptr<RageThread>> vpThreads;
+	for( int i = 1; i < iThreads; ++i )
+	{
+		vpThreads.emplace_back( new RageThread );
+		vpThreads.back()->SetName( ssprintf("Sound preload %i", i) );
+		vpThreads.back()->Create( PreloadThread, &job );
+	}
+	PreloadThread( &job );
+	for( std::unique_ptr<RageThread> &pThread : vpThreads )
+		pThread->Wait();
+
+	/* The sounds are added as-is, without making a copy: the caller is about to load
+	 * them, and the first copy keeps them alive past the next Update(). */
+	int iLoaded = 0;
+	{
+		LockMut( g_SoundManMutex );
+		for( unsigned i = 0; i < job.m_vsPaths.size(); ++i )
+		{
+			RageSoundReader_Preload *pSound = job.m_vpResults[i];
+			if( pSound == nullptr )
+				continue;
+
+			/* Another thread may have loaded it while we were decoding. */
+			RageSoundReader_Preload *&pEntry = m_mapPreloadedSounds[job.m_vsPaths[i]];
+			if( pEntry != nullptr )
+			{
+				delete pSound;
+				continue;
+			}
+			pEntry = pSound;
+			++iLoaded;
+		}
+	}
+
+	LOG->Trace( "Preloaded %i of %i sounds with %i threads in %.3f seconds",
+		iLoaded, (int) job.m_vsPaths.size(), iThreads, tStart.Ago() );
+}
+
 static Preference<float> g_fSoundVolume( "SoundVolume", 1.0f );
 
 void RageSoundManager::SetMixVolume()
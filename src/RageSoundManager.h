@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <map>
 #include <set>
+#include <vector>
 
 class RageSound;
 class RageSoundBase;
@@ -46,6 +47,13 @@ public:
 	RageSoundReader *GetLoadedSound( const RString &sPath );
 	void AddLoadedSound( const RString &sPath, RageSoundReader_Preload *pSound );
 
+	/* Decode the given sounds into the set of loaded sounds, in parallel.  Sounds
+	 * that are already loaded, and sounds too large to preload, are skipped.  Call
+	 * this before loading many precached sounds (eg. keysounds), so each RageSound::Load
+	 * is just a copy.  As with AddLoadedSound, sounds that nobody copies are released
+	 * on the next Update(). */
+	void PreloadSounds( const std::vector<RString> &vsPaths );
+
 	void fix_bogus_sound_driver_pref(RString const& valid_setting);
 	void low_sample_count_workaround();
 
@@ -0,0 +1,417 @@
+#include "global.h"
+#include "RageSoundPreviewCache.h"
+#include "RageSoundReader.h"
+#include "RageSoundReader_FileReader.h"
+#include "RageSoundUtil.h"
+#include "RageFile.h"
+#include "RageFileManager.h"
+#include "RageUtil.h"
+#include "RageLog.h"
+#include "Preference.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/* The number of decoded previews to keep in memory.  At 44.1kHz stereo, a
+ * typical 12 second preview is a little over 2MB. */
+static Preference<int> g_iPreviewMusicCacheSize( "PreviewMusicCacheSize", 12 );
+
+/* If true, decoded previews are also written to disk, so they survive restarts. */
+static Preference<bool> g_bPreviewMusicDiskCache( "PreviewMusicDiskCache", false );
+
+/* Decode a little past the end of the sample range, so fade outs and beat
+ * alignment (which may extend the length) don't need to touch the file. */
+static const float PREVIEW_EXTRA_SECONDS = 3.0f;
+
+static const RString PREVIEW_CACHE_DIR = "/Cache/PreviewMusic/";
+static const char PREVIEW_CACHE_MAGIC[4] = { 'S', 'M', 'P', 'V' };
+static const std::int32_t PREVIEW_CACHE_VERSION = 1;
+
+/* Plays a decoded segment of a file.  Positions are source frames of the whole
+ * file, so this is a drop-in replacement for the file reader.  If playback
+ * leaves the segment, open the file and continue from there. */
+class RageSoundReader_CachedSegment: public RageSoundReader
+{
+public:
+	RageSoundReader_CachedSegment( const RString &sFile, std::shared_ptr<const RageSoundPreviewCache::Segment> pSegment ):
+		m_sFile(sFile), m_pSegment(pSegment), m_iPosition(pSegment->m_iStartFrame),
+		m_pFallback(nullptr), m_bUsingFallback(false) { }
+	RageSoundReader_CachedSegment( const RageSoundReader_CachedSegment &cpy ):
+		RageSoundReader(cpy), m_sFile(cpy.m_sFile), m_pSegment(cpy.m_pSegment), m_iPosition(cpy.m_iPosition),
+		m_pFallback(cpy.m_pFallback? cpy.m_pFallback->Copy():nullptr), m_bUsingFallback(cpy.m_bUsingFallback),
+		m_sError(cpy.m_sError) { }
+	~RageSoundReader_CachedSegment() { delete m_pFallback; }
+
+	int GetLength() const { return m_pSegment->m_iLengthMS; }
+	int GetLength_Fast() const { return m_pSegment->m_iLengthMS; }
+	int SetPosition( int iFrame );
+	int Read( float *pBuf, int iFrames );
+	RageSoundReader *Copy() const { return new RageSoundReader_CachedSegment(*this); }
+	int GetSampleRate() const { return m_pSegment->m_iSampleRate; }
+	unsigned GetNumChannels() const { return m_pSegment->m_iChannels; }
+	int GetNextSourceFrame() const { return m_bUsingFallback? m_pFallback->GetNextSourceFrame():m_iPosition; }
+	float GetStreamToSourceRatio() const { return 1.0f; }
+	RString GetError() const { return m_bUsingFallback? m_pFallback->GetError():m_sError; }
+
+private:
+	bool IsInSegment( int iFrame ) const
+	{
+		return iFrame >= m_pSegment->m_iStartFrame &&
+			iFrame < m_pSegment->m_iStartFrame + m_pSegment->GetNumFrames();
+	}
+	bool SeekFallback( int iFrame );
+
+	RString m_sFile;
+	std::shared_ptr<const RageSoundPreviewCache::Segment> m_pSegment;
+	int m_iPosition;
+
+	/* The file reader is only opened once we leave the segment, and is kept
+	 * around in case we leave it again, which is likely when looping. */
+	RageSoundReader *m_pFallback;
+	bool m_bUsingFallback;
+	RString m_sError;
+};
+
+bool RageSoundReader_CachedSegment::SeekFallback( int iFrame )
+{
+	if( m_pFallback == nullptr )
+	{
+		RString sError;
+		m_pFallback = RageSoundReader_FileReader::OpenFile( m_sFile, sError );
+		if( m_pFallback == nullptr )
+		{
+			m_sError = sError;
+			return false;
+		}
+		LOG->Trace( "RageSoundPreviewCache: \"%s\" left the cached range at frame %i", m_sFile.c_str(), iFrame );
+	}
+
+	m_pFallback->SetPosition( iFrame );
+	m_bUsingFallback = true;
+	return true;
+}
+
+int RageSoundReader_CachedSegment::SetPosition( int iFrame )
+{
+	m_iPosition = iFrame;
+	if( IsInSegment(iFrame) )
+	{
+		m_bUsingFallback = false;
+		return 1;
+	}
+
+	if( iFrame >= m_pSegment->m_iStartFrame && m_pSegment->m_bReachedEOF )
+	{
+		/* Past the end of the file. */
+		m_bUsingFallback = false;
+		return 0;
+	}
+
+	if( !SeekFallback(iFrame) )
+		return -1;
+	return 1;
+}
+
+int RageSoundReader_CachedSegment::Read( float *pBuf, int iFrames )
+{
+	const RageSoundPreviewCache::Segment &seg = *m_pSegment;
+	const int iEndFrame = seg.m_iStartFrame + seg.GetNumFrames();
+
+	if( !m_bUsingFallback && !IsInSegment(m_iPosition) )
+	{
+		if( m_iPosition >= iEndFrame && seg.m_bReachedEOF )
+			return END_OF_FILE;
+		if( !SeekFallback(m_iPosition) )
+			return ERROR;
+	}
+
+	if( m_bUsingFallback )
+	{
+		int iGot = m_pFallback->Read( pBuf, iFrames );
+		if( iGot > 0 )
+			m_iPosition += iGot;
+		return iGot;
+	}
+
+	iFrames = std::min( iFrames, iEndFrame - m_iPosition );
+	const std::int16_t *pIn = seg.m_Data.data() + (m_iPosition - seg.m_iStartFrame) * seg.m_iChannels;
+	RageSoundUtil::ConvertNativeInt16ToFloat( pIn, pBuf, iFrames * seg.m_iChannels );
+	m_iPosition += iFrames;
+	return iFrames;
+}
+
+RageSoundPreviewCache::RageSoundPreviewCache():
+	m_bShutdownThread(false),
+	m_StartSem( "PreviewCacheSem" ),
+	m_Mutex( "PreviewCacheMutex" ),
+	m_iUseCounter(0)
+{
+	m_DecodeThread.SetName( "Preview music decode" );
+	m_DecodeThread.Create( DecodeThread_Start, this );
+}
+
+RageSoundPreviewCache::~RageSoundPreviewCache()
+{
+	ClearPrefetches();
+
+	m_bShutdownThread = true;
+	m_StartSem.Post();
+	m_DecodeThread.Wait();
+}
+
+RString RageSoundPreviewCache::GetKey( const RString &sFile, float fStartSecond, float fLengthSeconds )
+{
+	RString sPath( sFile );
+	sPath.MakeLower();
+	return ssprintf( "%s:%.3f:%.3f", sPath.c_str(), fStartSecond, fLengthSeconds );
+}
+
+RString RageSoundPreviewCache::GetDiskCachePath( const Request &req )
+{
+	/* Include the size and hash of the file, so the cache entry is invalidated
+	 * when the music is replaced. */
+	const RString sID = ssprintf( "%s:%i:%i",
+		GetKey(req.m_sFile, req.m_fStartSecond, req.m_fLengthSeconds).c_str(),
+		FILEMAN->GetFileSizeInBytes(req.m_sFile), FILEMAN->GetFileHash(req.m_sFile) );
+	return PREVIEW_CACHE_DIR + ssprintf( "%08x", GetHashForString(sID) ) + ".pcm";
+}
+
+void RageSoundPreviewCache::Prefetch( const RString &sFile, float fStartSecond, float fLengthSeconds )
+{
+	if( sFile.empty() || g_iPreviewMusicCacheSize.Get() <= 0 )
+		return;
+
+	Request req;
+	req.m_sFile = sFile;
+	req.m_fStartSecond = fStartSecond;
+	req.m_fLengthSeconds = fLengthSeconds;
+
+	LockMut( m_Mutex );
+	m_Requests.push_back( req );
+	m_StartSem.Post();
+}
+
+void RageSoundPreviewCache::ClearPrefetches()
+{
+	LockMut( m_Mutex );
+	m_Requests.clear();
+}
+
+void RageSoundPreviewCache::Clear()
+{
+	LockMut( m_Mutex );
+	m_Entries.clear();
+}
+
+RageSoundReader *RageSoundPreviewCache::GetCachedPreview( const RString &sFile, float fStartSecond, float fLengthSeconds )
+{
+	LockMut( m_Mutex );
+	std::map<RString, CacheEntry>::iterator it = m_Entries.find( GetKey(sFile, fStartSecond, fLengthSeconds) );
+	if( it == m_Entries.end() )
+		return nullptr;
+
+	it->second.m_iLastUsed = ++m_iUseCounter;
+	return new RageSoundReader_CachedSegment( sFile, it->second.m_pSegment );
+}
+
+void RageSoundPreviewCache::AddEntry( const RString &sKey, std::shared_ptr<const Segment> pSegment )
+{
+	LockMut( m_Mutex );
+	CacheEntry &entry = m_Entries[sKey];
+	entry.m_pSegment = pSegment;
+	entry.m_iLastUsed = ++m_iUseCounter;
+
+	/* Evict the least recently used segments. */
+	while( (int) m_Entries.size() > std::max(g_iPreviewMusicCacheSize.Get(), 1) )
+	{
+		std::map<RString, CacheEntry>::iterator oldest = m_Entries.begin();
+		for( std::map<RString, CacheEntry>::iterator i = m_Entries.begin(); i != m_Entries.end(); ++i )
+			if( i->second.m_iLastUsed < oldest->second.m_iLastUsed )
+				oldest = i;
+		m_Entries.erase( oldest );
+	}
+}
+
+std::shared_ptr<const RageSoundPreviewCache::Segment> RageSoundPreviewCache::DecodeSegment( const Request &req ) const
+{
+	RString sError;
+	RageSoundReader *pSource = RageSoundReader_FileReader::OpenFile( req.m_sFile, sError );
+	if( pSource == nullptr )
+	{
+		LOG->Trace( "RageSoundPreviewCache: couldn't open \"%s\": %s", req.m_sFile.c_str(), sError.c_str() );
+		return nullptr;
+	}
+
+	std::shared_ptr<Segment> pSeg = std::make_shared<Segment>();
+	pSeg->m_iSampleRate = pSource->GetSampleRate();
+	pSeg->m_iChannels = pSource->GetNumChannels();
+	pSeg->m_iLengthMS = pSource->GetLength_Fast();
+	pSeg->m_iStartFrame = std::max( 0, (int) std::lrint(req.m_fStartSecond * pSeg->m_iSampleRate) );
+
+	int iFramesLeft = -1;
+	if( req.m_fLengthSeconds >= 0 )
+		iFramesLeft = (int) std::lrint( (req.m_fLengthSeconds + PREVIEW_EXTRA_SECONDS) * pSeg->m_iSampleRate );
+
+	if( pSource->SetPosition(pSeg->m_iStartFrame) <= 0 )
+	{
+		delete pSource;
+		return nullptr;
+	}
+
+	if( iFramesLeft > 0 )
+		pSeg->m_Data.reserve( iFramesLeft * pSeg->m_iChannels );
+
+	float buffer[1024];
+	std::int16_t buffer16[1024];
+	const int iBufferFrames = ARRAYLEN(buffer) / pSeg->m_iChannels;
+	while( iFramesLeft != 0 && !m_bShutdownThread )
+	{
+		int iWant = iFramesLeft < 0? iBufferFrames:std::min( iBufferFrames, iFramesLeft );
+		int iGot = pSource->RetriedRead( buffer, iWant );
+		if( iGot == RageSoundReader::END_OF_FILE )
+		{
+			pSeg->m_bReachedEOF = true;
+			break;
+		}
+		if( iGot < 0 )
+		{
+			LOG->Trace( "RageSoundPreviewCache: error decoding \"%s\": %s", req.m_sFile.c_str(), pSource->GetError().c_str() );
+			delete pSource;
+			return nullptr;
+		}
+
+		RageSoundUtil::ConvertFloatToNativeInt16( buffer, buffer16, iGot * pSeg->m_iChannels );
+		pSeg->m_Data.insert( pSeg->m_Data.end(), buffer16, buffer16 + iGot * pSeg->m_iChannels );
+		if( iFramesLeft > 0 )
+			iFramesLeft -= iGot;
+	}
+
+	delete pSource;
+	if( m_bShutdownThread || pSeg->m_Data.empty() )
+		return nullptr;
+	return pSeg;
+}
+
+std::shared_ptr<const RageSoundPreviewCache::Segment> RageSoundPreviewCache::LoadFromDisk( const Request &req ) const
+{
+	RageFile f;
+	if( !f.Open(GetDiskCachePath(req), RageFile::READ) )
+		return nullptr;
+
+	char magic[4];
+	std::int32_t iVersion, iSampleRate, iChannels, iStartFrame, iLengthMS, iEOF, iSamples;
+	if( f.Read(magic, sizeof(magic)) != sizeof(magic) || memcmp(magic, PREVIEW_CACHE_MAGIC, sizeof(magic)) )
+		return nullptr;
+	if( f.Read(&iVersion, sizeof(iVersion)) != sizeof(iVersion) || iVersion != PREVIEW_CACHE_VERSION )
+		return nullptr;
+	if( f.Read(&iSampleRate, sizeof(std::int32_t)) != sizeof(std::int32_t) ||
+		f.Read(&iChannels, sizeof(std::int32_t)) != sizeof(std::int32_t) ||
+		f.Read(&iStartFrame, sizeof(std::int32_t)) != sizeof(std::int32_t) ||
+		f.Read(&iLengthMS, sizeof(std::int32_t)) != sizeof(std::int32_t) ||
+		f.Read(&iEOF, sizeof(std::int32_t)) != sizeof(std::int32_t) ||
+		f.Read(&iSamples, sizeof(std::int32_t)) != sizeof(std::int32_t) )
+		return nullptr;
+	if( iSampleRate <= 0 || iChannels <= 0 || iSamples <= 0 || iSamples % iChannels )
+		return nullptr;
+
+	std::shared_ptr<Segment> pSeg = std::make_shared<Segment>();
+	pSeg->m_iSampleRate = iSampleRate;
+	pSeg->m_iChannels = iChannels;
+	pSeg->m_iStartFrame = iStartFrame;
+	pSeg->m_iLengthMS = iLengthMS;
+	pSeg->m_bReachedEOF = iEOF != 0;
+	pSeg->m_Data.resize( iSamples );
+
+	const int iBytes = iSamples * sizeof(std::int16_t);
+	if( f.Read(pSeg->m_Data.data(), iBytes) != iBytes )
+		return nullptr;
+	return pSeg;
+}
+
+void RageSoundPreviewCache::SaveToDisk( const Request &req, const Segment &seg ) const
+{
+	RageFile f;
+	if( !f.Open(GetDiskCachePath(req), RageFile::WRITE) )
+		return;
+
+	const std::int32_t aHeader[] = {
+		PREVIEW_CACHE_VERSION,
+		seg.m_iSampleRate,
+		(std::int32_t) seg.m_iChannels,
+		seg.m_iStartFrame,
+		seg.m_iLengthMS,
+		seg.m_bReachedEOF? 1:0,
+		(std::int32_t) seg.m_Data.size()
+	};
+	f.Write( PREVIEW_CACHE_MAGIC, sizeof(PREVIEW_CACHE_MAGIC) );
+	f.Write( aHeader, sizeof(aHeader) );
+	f.Write( seg.m_Data.data(), seg.m_Data.size() * sizeof(std::int16_t) );
+}
+
+void RageSoundPreviewCache::DecodeThread()
+{
+	while( !m_bShutdownThread )
+	{
+		/* Wait for a request.  It's normal for this to wait for a long time; don't
+		 * fail on timeout. */
+		m_StartSem.Wait( false );
+
+		Request req;
+		RString sKey;
+		{
+			LockMut( m_Mutex );
+			if( m_Requests.empty() )
+				continue;
+			req = m_Requests.front();
+			m_Requests.erase( m_Requests.begin() );
+
+			sKey = GetKey( req.m_sFile, req.m_fStartSecond, req.m_fLengthSeconds );
+			std::map<RString, CacheEntry>::iterator it = m_Entries.find( sKey );
+			if( it != m_Entries.end() )
+			{
+				it->second.m_iLastUsed = ++m_iUseCounter;
+				continue;
+			}
+		}
+
+		std::shared_ptr<const Segment> pSeg;
+		if( g_bPreviewMusicDiskCache.Get() )
+			pSeg = LoadFromDisk( req );
+		if( pSeg == nullptr )
+		{
+			pSeg = DecodeSegment( req );
+			if( pSeg != nullptr && g_bPreviewMusicDiskCache.Get() )
+				SaveToDisk( req, *pSeg );
+		}
+
+		if( pSeg != nullptr )
+			AddEntry( sKey, pSeg );
+	}
+}
+
+/*
+ * (c) 2026 ITGmania team
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, and/or sell copies of the Software, and to permit persons to
+ * whom the Software is furnished to do so, provided that the above
+ * copyright notice(s) and this permission notice appear in all copies of
+ * the Software and that both the above copyright notice(s) and this
+ * permission notice appear in supporting documentation.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF
+ * THIRD PARTY RIGHTS. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR HOLDERS
+ * INCLUDED IN THIS NOTICE BE LIABLE FOR ANY CLAIM, OR ANY SPECIAL INDIRECT
+ * OR CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
@@ -0,0 +1,122 @@
+/* RageSoundPreviewCache - Decode music preview segments in a thread. */
+
+#ifndef RAGE_SOUND_PREVIEW_CACHE_H
+#define RAGE_SOUND_PREVIEW_CACHE_H
+
+#include "RageThreads.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+class RageSoundReader;
+
+/* Seeking into a long MP3 or OGG and decoding from there can take long enough
+ * that sample music starts noticeably late.  This decodes the sample range of
+ * songs we expect to play soon in the background, keeps them in memory (and,
+ * optionally, on disk) as 16-bit PCM, and hands out readers for them. */
+class RageSoundPreviewCache
+{
+public:
+	RageSoundPreviewCache();
+
+	/* Destruction waits for the decode thread to finish its current request. */
+	~RageSoundPreviewCache();
+
+	/* Decode the given range in the background.  Requests are handled in the
+	 * order queued. */
+	void Prefetch( const RString &sFile, float fStartSecond, float fLengthSeconds );
+
+	/* Discard pending prefetches that haven't started yet.  Call this before
+	 * queueing a new set, so we don't waste time on songs the wheel has
+	 * already scrolled past. */
+	void ClearPrefetches();
+
+	/* If the range is cached, return a reader for sFile that plays the cached
+	 * data.  Reads outside of the cached range fall back on decoding the file.
+	 * Otherwise, return nullptr. */
+	RageSoundReader *GetCachedPreview( const RString &sFile, float fStartSecond, float fLengthSeconds );
+
+	/* Drop all cached segments. */
+	void Clear();
+
+	struct Segment
+	{
+		Segment(): m_iSampleRate(0), m_iChannels(0), m_iStartFrame(0),
+			m_iLengthMS(0), m_bReachedEOF(false) { }
+		int GetNumFrames() const { return m_Data.size() / m_iChannels; }
+
+		std::vector<std::int16_t> m_Data;
+		int m_iSampleRate;
+		unsigned m_iChannels;
+		int m_iStartFrame;
+		/* The length of the whole file, as reported by its reader. */
+		int m_iLengthMS;
+		/* If true, the segment extends to the end of the file. */
+		bool m_bReachedEOF;
+	};
+
+private:
+	struct Request
+	{
+		RString m_sFile;
+		float m_fStartSecond;
+		float m_fLengthSeconds;
+	};
+
+	struct CacheEntry
+	{
+		std::shared_ptr<const Segment> m_pSegment;
+		std::uint64_t m_iLastUsed;
+	};
+
+	static RString GetKey( const RString &sFile, float fStartSecond, float fLengthSeconds );
+	static RString GetDiskCachePath( const Request &req );
+	std::shared_ptr<const Segment> DecodeSegment( const Request &req ) const;
+	std::shared_ptr<const Segment> LoadFromDisk( const Request &req ) const;
+	void SaveToDisk( const Request &req, const Segment &seg ) const;
+	void AddEntry( const RString &sKey, std::shared_ptr<const Segment> pSegment );
+
+	RageThread m_DecodeThread;
+	bool m_bShutdownThread;
+	void DecodeThread();
+	static int DecodeThread_Start( void *p ) { ((RageSoundPreviewCache *) p)->DecodeThread(); return 0; }
+
+	RageSemaphore m_StartSem;
+
+	/* Lock before accessing any of the rest of the object.  Don't keep this locked
+	 * while decoding. */
+	RageMutex m_Mutex;
+
+	std::vector<Request> m_Requests;
+	std::map<RString, CacheEntry> m_Entries;
+	std::uint64_t m_iUseCounter;
+};
+
+#endif
+
+/*
+ * (c) 2026 ITGmania team
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, and/or sell copies of the Software, and to permit persons to
+ * whom the Software is furnished to do so, provided that the above
+ * copyright notice(s) and this permission notice appear in all copies of
+ * the Software and that both the above copyright notice(s) and this
+ * permission notice appear in supporting documentation.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF
+ * THIRD PARTY RIGHTS. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR HOLDERS
+ * INCLUDED IN THIS NOTICE BE LIABLE FOR ANY CLAIM, OR ANY SPECIAL INDIRECT
+ * OR CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+ * OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
@@ -4,6 +4,7 @@
 #include "RageSoundReader_Resample_Good.h"
 #include "RageSoundReader_Preload.h"
 #include "RageSoundReader_Pan.h"
+#include "RageSoundManager.h"
 #include "RageLog.h"
 #include "RageUtil.h"
 #include "RageSoundMixBuffer.h"
@@ -85,9 +86,14 @@ int RageSoundReader_Chain::LoadSound( RString sPath )
 		FAIL_M( sPath );
 	}
 
+	/* If SOUNDMAN already has this sound preloaded (eg. from RageSoundManager::PreloadSounds),
+	 * share its data instead of decoding it again. */
+	RageSoundReader *pReader = SOUNDMAN->GetLoadedSound( sPath );
+
 	RString sError;
 	bool bPrebuffer;
-	RageSoundReader *pReader = RageSoundReader_FileReader::OpenFile( sPath, sError, &bPrebuffer );
+	if( pReader == nullptr )
+		pReader = RageSoundReader_FileReader::OpenFile( sPath, sError, &bPrebuffer );
 	if( pReader == nullptr )
 	{
 		LOG->Warn( "RageSoundReader_Chain: error opening sound \"%s\": %s",
@@ -116,6 +122,8 @@ int RageSoundReader_Chain::GetSampleRateInternal() const
 	int iRate = -1;
 	for (RageSoundReader const *it : m_apLoadedSounds)
 	{
+		if( it == nullptr )
+			continue;
 		if( iRate == -1 )
 			iRate = it->GetSampleRate();
 		else if( iRate != it->GetSampleRate() )
@@ -134,7 +142,7 @@ void RageSoundReader_Chain::Finish()
 
 	if( m_iChannels > 2 )
 	{
-		for (RageSoundReader *it : m_apLoadedSounds)
+		for (RageSoundReader *&it : m_apLoadedSounds)
 		{
 			if( it->GetNumChannels() != m_iChannels )
 			{
@@ -169,8 +177,10 @@ void RageSoundReader_Chain::Finish()
 	m_iActualSampleRate = GetSampleRateInternal();
 	if( m_iActualSampleRate == -1 )
 	{
-		for (RageSoundReader *it : m_apLoadedSounds)
+		for (RageSoundReader *&it : m_apLoadedSounds)
 		{
+			if( it == nullptr )
+				continue;
 			RageSoundReader_Resample_Good *pResample = new RageSoundReader_Resample_Good( it, m_iPreferredSampleRate );
 			it = pResample;
 		}
@@ -178,9 +188,12 @@ void RageSoundReader_Chain::Finish()
 		m_iActualSampleRate = m_iPreferredSampleRate;
 	}
 
-	/* Attempt to preload all sounds. */
-	for (RageSoundReader *it : m_apLoadedSounds)
+	/* Attempt to preload all sounds.  Sounds that came from SOUNDMAN are already
+	 * preloaded; don't make another copy of their data. */
+	for (RageSoundReader *&it : m_apLoadedSounds)
 	{
+		if( it == nullptr || dynamic_cast<RageSoundReader_Preload *>(it) != nullptr )
+			continue;
 		RageSoundReader_Preload::PreloadSound( it );
 	}
 
@@ -4,6 +4,7 @@
 #include "RageSoundReader_MP3.h"
 #include "RageLog.h"
 #include "RageUtil.h"
+#include "RageFileManager.h"
 
 #include <cerrno>
 #include <cstdint>
@@ -187,6 +188,8 @@ struct madlib_t
 		length = 0;
 		framelength = mad_timer_zero;
 		bitrate = 0;
+		seek_table_built = false;
+		seek_table_frames = -1;
 	}
 
 	std::uint8_t inbuf[16384];
@@ -218,6 +221,12 @@ struct madlib_t
 	typedef std::map<mad_timer_t, int, mad_timer_compare_lt> tocmap_t;
 	tocmap_t tocmap;
 
+	/* Whether we've tried to fill tocmap from a full scan of the file (or its
+	 * saved seek table), and if that succeeded, the number of frames in the
+	 * file; otherwise -1. */
+	bool seek_table_built;
+	int seek_table_frames;
+
 	/* Position in the file of inbuf: */
 	int inbuf_filepos;
 
@@ -259,6 +268,14 @@ static float scale(mad_fixed_t sample)
 	return float( double(sample) / (1<<MAD_F_FRACBITS) );
 }
 
+/* Seek tables index every SEEK_TABLE_INTERVAL frames (about 0.4 seconds at
+ * 44.1kHz), so an accurate seek decodes at most that many frames past the
+ * indexed one.  They're saved in SEEK_TABLE_DIR, so we only scan each file once. */
+static const int SEEK_TABLE_INTERVAL = 16;
+static const RString SEEK_TABLE_DIR = "/Cache/MP3SeekTables/";
+static const char SEEK_TABLE_MAGIC[4] = { 'S', 'M', 'S', 'T' };
+static const std::int32_t SEEK_TABLE_VERSION = 1;
+
 static int get_this_frame_byte( const madlib_t *mad )
 {
 	int ret = mad->inbuf_filepos;
@@ -631,6 +648,16 @@ RageSoundReader_FileReader::OpenResult RageSoundReader_MP3::Open( RageFileBasic
 {
 	m_pFile = pFile;
 
+	/* Seek tables are keyed by path, so we can only persist them for real files. */
+	const RageFile *pRageFile = dynamic_cast<const RageFile *>( pFile );
+	if( pRageFile != nullptr )
+	{
+		const RString &sPath = pRageFile->GetRealPath();
+		const RString sID = ssprintf( "%s:%i:%i", sPath.c_str(),
+			FILEMAN->GetFileSizeInBytes(sPath), FILEMAN->GetFileHash(sPath) );
+		m_sSeekTablePath = SEEK_TABLE_DIR + ssprintf( "%08x", GetHashForString(sID) ) + ".idx";
+	}
+
 	mad->filesize = m_pFile->GetFileSize();
 	ASSERT( mad->filesize != -1 );
 
@@ -668,6 +695,11 @@ RageSoundReader_FileReader::OpenResult RageSoundReader_MP3::Open( RageFileBasic
 		mad->length = (int)(secs * 1000.f);
 	}
 
+	/* If this file has been indexed before, use the saved index.  This is cheap,
+	 * so do it now, so quick seeks are accurate, too. */
+	if( LoadSeekTable() )
+		mad->seek_table_built = true;
+
 	return OPEN_OK;
 }
 
@@ -685,6 +717,10 @@ RageSoundReader_MP3 *RageSoundReader_MP3::Copy() const
 	ret->mad->framelength = mad->framelength;
 	ret->Channels = Channels;
 	ret->mad->length = mad->length;
+	ret->m_sSeekTablePath = m_sSeekTablePath;
+	ret->mad->tocmap = mad->tocmap;
+	ret->mad->seek_table_built = mad->seek_table_built;
+	ret->mad->seek_table_frames = mad->seek_table_frames;
 
 //	int n = ret->do_mad_frame_decode();
 //	ASSERT( n > 0 );
@@ -822,6 +858,10 @@ int RageSoundReader_MP3::SetPosition_toc( int iFrame, bool Xing )
 
 	if( bytepos != -1 )
 	{
+		/* Decoding the frames leading up to bytepos advances the timer; it
+		 * needs to be the timestamp of the frame at bytepos when we're done. */
+		const mad_timer_t timer = mad->Timer;
+
 		/* Seek backwards up to 4k. */
 		const int seekpos = std::max( 0, bytepos - 1024*4 );
 		seek_stream_to_byte( seekpos );
@@ -832,6 +872,8 @@ int RageSoundReader_MP3::SetPosition_toc( int iFrame, bool Xing )
 			if( ret <= 0 )
 				return ret; /* it set the error */
 		} while( get_this_frame_byte(mad) < bytepos );
+
+		mad->Timer = timer;
 		synth_output();
 	}
 
@@ -960,7 +1002,14 @@ int RageSoundReader_MP3::SetPosition_estimate( int iFrame )
 
 int RageSoundReader_MP3::SetPosition( int iFrame )
 {
-	if( m_bAccurateSync )
+	/* Accurate seeks need an index of the whole file, or they'll have to decode
+	 * from the last indexed position, which may be the start of the file. */
+	if( m_bAccurateSync && !mad->seek_table_built )
+		BuildSeekTable();
+
+	/* If we have an index of the whole file, accurate seeks are cheap, so use
+	 * them even if we weren't asked to. */
+	if( m_bAccurateSync || mad->seek_table_frames != -1 )
 	{
 		/* Seek using our own internal (accurate) TOC. */
 		int ret = SetPosition_toc( iFrame, false );
@@ -1000,6 +1049,119 @@ bool RageSoundReader_MP3::SetProperty( const RString &sProperty, float fValue )
 	return RageSoundReader_FileReader::SetProperty( sProperty, fValue );
 }
 
+/* Scan the headers of every frame in the file, indexing every SEEK_TABLE_INTERVAL
+ * frames.  Header decoding is much cheaper than decoding audio, and afterwards
+ * accurate seeks never need to decode from the beginning of the file. */
+bool RageSoundReader_MP3::BuildSeekTable()
+{
+	/* Only try once, even if this fails. */
+	mad->seek_table_built = true;
+
+	if( LoadSeekTable() )
+		return true;
+
+	MADLIB_rewind();
+	mad->timer_accurate = 1;
+
+	madlib_t::tocmap_t toc;
+	int iFrameNo = 0;
+	for(;;)
+	{
+		int ret = do_mad_frame_decode( true );
+		if( ret == -1 )
+		{
+			LOG->Trace( "Couldn't index \"%s\": %s", m_pFile->GetDisplayPath().c_str(), GetError().c_str() );
+			MADLIB_rewind();
+			return false;
+		}
+		if( ret == 0 ) /* EOF */
+			break;
+
+		if( iFrameNo % SEEK_TABLE_INTERVAL == 0 )
+			toc[mad->Timer] = get_this_frame_byte( mad );
+		++iFrameNo;
+	}
+
+	mad->tocmap.swap( toc );
+	mad->seek_table_frames = iFrameNo;
+	MADLIB_rewind();
+
+	SaveSeekTable();
+	return true;
+}
+
+bool RageSoundReader_MP3::LoadSeekTable()
+{
+	if( m_sSeekTablePath.empty() )
+		return false;
+
+	RageFile f;
+	if( !f.Open(m_sSeekTablePath, RageFile::READ) )
+		return false;
+
+	char magic[4];
+	std::int32_t aHeader[4];
+	if( f.Read(magic, sizeof(magic)) != sizeof(magic) || memcmp(magic, SEEK_TABLE_MAGIC, sizeof(magic)) )
+		return false;
+	if( f.Read(aHeader, sizeof(aHeader)) != sizeof(aHeader) )
+		return false;
+
+	const std::int32_t iVersion = aHeader[0], iFileSize = aHeader[1], iFrames = aHeader[2], iEntries = aHeader[3];
+	if( iVersion != SEEK_TABLE_VERSION || iFileSize != mad->filesize || iFrames < 0 || iEntries <= 0 )
+		return false;
+
+	madlib_t::tocmap_t toc;
+	for( int i = 0; i < iEntries; ++i )
+	{
+		/* seconds, fraction, byte */
+		std::int32_t aEntry[3];
+		if( f.Read(aEntry, sizeof(aEntry)) != sizeof(aEntry) )
+			return false;
+		if( aEntry[2] < 0 || aEntry[2] >= mad->filesize )
+			return false;
+
+		mad_timer_t tm;
+		tm.seconds = aEntry[0];
+		tm.fraction = (unsigned long) (std::uint32_t) aEntry[1];
+		toc[tm] = aEntry[2];
+	}
+
+	mad->tocmap.swap( toc );
+	mad->seek_table_frames = iFrames;
+	return true;
+}
+
+void RageSoundReader_MP3::SaveSeekTable() const
+{
+	if( m_sSeekTablePath.empty() || mad->seek_table_frames == -1 )
+		return;
+
+	RageFile f;
+	if( !f.Open(m_sSeekTablePath, RageFile::WRITE) )
+	{
+		LOG->Trace( "Couldn't write seek table \"%s\": %s", m_sSeekTablePath.c_str(), f.GetError().c_str() );
+		return;
+	}
+
+	const std::int32_t aHeader[4] = {
+		SEEK_TABLE_VERSION,
+		mad->filesize,
+		mad->seek_table_frames,
+		(std::int32_t) mad->tocmap.size()
+	};
+	f.Write( SEEK_TABLE_MAGIC, sizeof(SEEK_TABLE_MAGIC) );
+	f.Write( aHeader, sizeof(aHeader) );
+	for( madlib_t::tocmap_t::const_iterator it = mad->tocmap.begin(); it != mad->tocmap.end(); ++it )
+	{
+		const std::int32_t aEntry[3] = {
+			(std::int32_t) it->first.seconds,
+			(std::int32_t) it->first.fraction,
+			it->second
+		};
+		f.Write( aEntry, sizeof(aEntry) );
+	}
+}
+
 int RageSoundReader_MP3::GetNextSourceFrame() const
 {
 	int iFrame = mad_timer_count( mad->Timer, mad_units(mad->Frame.header.samplerate) );
@@ -1012,6 +1174,14 @@ int RageSoundReader_MP3::GetLengthInternal( bool fast )
 	if( mad->has_xing && mad->length != -1 )
 		return mad->length; /* should be accurate */
 
+	/* If we've indexed the file, we know exactly how many frames it has. */
+	if( mad->seek_table_frames != -1 )
+	{
+		mad_timer_t end = mad->framelength;
+		mad_timer_multiply( &end, mad->seek_table_frames );
+		return mad_timer_count( end, MAD_UNITS_MILLISECONDS );
+	}
+
 	/* Check to see if a frame in the middle of the file is the same
 	 * bitrate as the first frame.  If it is, assume the file is really CBR. */
 	seek_stream_to_byte( mad->filesize / 2 );
@@ -39,6 +39,11 @@ private:
 
 	madlib_t *mad;
 
+	/* Where the seek table for this file is saved; empty if we can't save it. */
+	RString m_sSeekTablePath;
+	bool BuildSeekTable();
+	bool LoadSeekTable();
+	void SaveSeekTable() const;
 
 	bool MADLIB_rewind();
 	int SetPosition_toc( int iSample, bool Xing );
@@ -3,8 +3,13 @@
 #ifndef RAGE_UTIL_CIRCULAR_BUFFER
 #define RAGE_UTIL_CIRCULAR_BUFFER
 
+#include <atomic>
+
 /* Lock-free circular buffer.  This should be threadsafe if one thread is reading
- * and another is writing. */
+ * and another is writing.  Neither side ever waits on the other: the writer
+ * publishes data by storing write_pos with release semantics, and the reader
+ * hands space back by storing read_pos the same way, so the data itself needs
+ * no further synchronization. */
 template<class T>
 class CircBuf
 {
@@ -19,8 +24,14 @@ class CircBuf
 	unsigned size;
 	unsigned m_iBlockSize;
 
-	/* These are volatile to prevent reads and writes to them from being optimized. */
-	volatile unsigned read_pos, write_pos;
+	/* Each position is only stored by the side that owns it: read_pos by the
+	 * reader and write_pos by the writer.  Keep them on separate cache lines,
+	 * so the two threads don't contend for the same line on every update. */
+	alignas(64) std::atomic<unsigned> read_pos;
+	alignas(64) std::atomic<unsigned> write_pos;
+
+	unsigned load_read_pos() const { return read_pos.load( std::memory_order_acquire ); }
+	unsigned load_write_pos() const { return write_pos.load( std::memory_order_acquire ); }
 
 public:
 	CircBuf()
@@ -38,8 +49,11 @@ public:
 	{
 		std::swap( size, rhs.size );
 		std::swap( m_iBlockSize, rhs.m_iBlockSize );
-		std::swap( read_pos, rhs.read_pos );
-		std::swap( write_pos, rhs.write_pos );
+		const unsigned rpos = load_read_pos(), wpos = load_write_pos();
+		read_pos.store( rhs.load_read_pos(), std::memory_order_release );
+		write_pos.store( rhs.load_write_pos(), std::memory_order_release );
+		rhs.read_pos.store( rpos, std::memory_order_release );
+		rhs.write_pos.store( wpos, std::memory_order_release );
 		std::swap( buf, rhs.buf );
 	}
 
@@ -53,8 +67,8 @@ public:
 	CircBuf( const CircBuf &cpy )
 	{
 		size = cpy.size;
-		read_pos = cpy.read_pos;
-		write_pos = cpy.write_pos;
+		read_pos.store( cpy.load_read_pos(), std::memory_order_relaxed );
+		write_pos.store( cpy.load_write_pos(), std::memory_order_relaxed );
 		m_iBlockSize = cpy.m_iBlockSize;
 		if( size )
 		{
@@ -70,8 +84,8 @@ public:
 	/* Return the number of elements available to read. */
 	unsigned num_readable() const
 	{
-		const int rpos = read_pos;
-		const int wpos = write_pos;
+		const int rpos = load_read_pos();
+		const int wpos = load_write_pos();
 		if( rpos < wpos )
 			/* The buffer looks like "eeeeDDDDeeee" (e = empty, D = data). */
 			return wpos - rpos;
@@ -86,8 +100,8 @@ public:
 	/* Return the number of writable elements. */
 	unsigned num_writable() const
 	{
-		const int rpos = read_pos;
-		const int wpos = write_pos;
+		const int rpos = load_read_pos();
+		const int wpos = load_write_pos();
 
 		int ret;
 		if( rpos < wpos )
@@ -131,26 +145,28 @@ public:
 
 	void clear()
 	{
-		read_pos = 0;
-		write_pos = 0;
+		read_pos.store( 0, std::memory_order_release );
+		write_pos.store( 0, std::memory_order_release );
 	}
 
 	/* Indicate that n elements have been written. */
 	void advance_write_pointer( int n )
 	{
-		write_pos = (write_pos + n) % size;
+		const unsigned wpos = write_pos.load( std::memory_order_relaxed );
+		write_pos.store( (wpos + n) % size, std::memory_order_release );
 	}
 	
 	/* Indicate that n elements have been read. */
 	void advance_read_pointer( int n )
 	{
-		read_pos = (read_pos + n) % size;
+		const unsigned rpos = read_pos.load( std::memory_order_relaxed );
+		read_pos.store( (rpos + n) % size, std::memory_order_release );
 	}
 	
 	void get_write_pointers( T *pPointers[2], unsigned pSizes[2] )
 	{
-		const int rpos = read_pos;
-		const int wpos = write_pos;
+		const int rpos = load_read_pos();
+		const int wpos = load_write_pos();
 
 		if( rpos <= wpos )
 		{
@@ -191,8 +207,8 @@ public:
 
 	void get_read_pointers( T *pPointers[2], unsigned pSizes[2] )
 	{
-		const int rpos = read_pos;
-		const int wpos = write_pos;
+		const int rpos = load_read_pos();
+		const int wpos = load_write_pos();
 
 		if( rpos < wpos )
 		{
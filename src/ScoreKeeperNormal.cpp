@@ -34,6 +34,7 @@ static ThemeMetric1D<int> g_iGradeWeight("ScoreKeeperNormal", GradeWeightName, N
 ScoreKeeperNormal::ScoreKeeperNormal( PlayerState *pPlayerState, PlayerStageStats *pPlayerStageStats ):
 	ScoreKeeper(pPlayerState, pPlayerStageStats)
 {
+	m_bSendMessages = true;
 }
 
 void ScoreKeeperNormal::Load(
@@ -128,7 +129,8 @@ void ScoreKeeperNormal::Load(
 	Message msg( "ScoreChanged" );
 	msg.SetParam( "PlayerNumber", m_pPlayerState->m_PlayerNumber );
 	msg.SetParam( "MultiPlayer", m_pPlayerState->m_mp );
-	MESSAGEMAN->Broadcast( msg );
+	if( m_bSendMessages )
+		MESSAGEMAN->Broadcast( msg );
 
 	memset( m_ComboBonusFactor, 0, sizeof(m_ComboBonusFactor) );
 	m_iRoundTo = 1;
@@ -261,7 +263,7 @@ void ScoreKeeperNormal::HandleTapScoreNone()
 	{
 		m_pPlayerStageStats->m_iCurCombo = 0;
 
-		if( m_pPlayerState->m_PlayerNumber != PLAYER_INVALID )
+		if( m_bSendMessages && m_pPlayerState->m_PlayerNumber != PLAYER_INVALID )
 			MESSAGEMAN->Broadcast( enum_add2(Message_CurrentComboChangedP1,m_pPlayerState->m_PlayerNumber) );
 	}
 
@@ -420,7 +422,8 @@ void ScoreKeeperNormal::HandleTapScore( const TapNote &tn )
 		Message msg( "ScoreChanged" );
 		msg.SetParam( "PlayerNumber", m_pPlayerState->m_PlayerNumber );
 		msg.SetParam( "MultiPlayer", m_pPlayerState->m_mp );
-		MESSAGEMAN->Broadcast( msg );
+		if( m_bSendMessages )
+			MESSAGEMAN->Broadcast( msg );
 	}
 
 	AddTapScore( tns );
@@ -556,7 +559,7 @@ void ScoreKeeperNormal::HandleTapRowScore( const NoteData &nd, int iRow )
 		HandleRowComboInternal( scoreOfLastTap, iNumTapsInRow, iRow ); //This should work?
 	}
 
-	if( m_pPlayerState->m_PlayerNumber != PLAYER_INVALID )
+	if( m_bSendMessages && m_pPlayerState->m_PlayerNumber != PLAYER_INVALID )
 		MESSAGEMAN->Broadcast( enum_add2(Message_CurrentComboChangedP1,m_pPlayerState->m_PlayerNumber) );
 
 	AddTapRowScore( scoreOfLastTap, nd, iRow );		// only score once per row
@@ -576,7 +579,7 @@ void ScoreKeeperNormal::HandleTapRowScore( const NoteData &nd, int iRow )
 	{
 		m_cur_toasty_combo += iNumTapsInRow;
 		if(m_cur_toasty_combo > m_next_toasty_at &&
-			!GAMESTATE->m_bDemonstrationOrJukebox)
+			!GAMESTATE->m_bDemonstrationOrJukebox && m_bSendMessages)
 		{
 			++m_cur_toasty_level;
 			// Broadcast the message before posting the screen message so that the
@@ -602,7 +605,8 @@ void ScoreKeeperNormal::HandleTapRowScore( const NoteData &nd, int iRow )
 		m_next_toasty_at= CalcNextToastyAt(m_cur_toasty_level);
 		Message msg("ToastyDropped");
 		msg.SetParam( "PlayerNumber", m_pPlayerState->m_PlayerNumber );
-		MESSAGEMAN->Broadcast(msg);
+		if( m_bSendMessages )
+			MESSAGEMAN->Broadcast(msg);
 	}
 
 	// TODO: Remove indexing with PlayerNumber
@@ -612,7 +616,8 @@ void ScoreKeeperNormal::HandleTapRowScore( const NoteData &nd, int iRow )
 	msg.SetParam( "PlayerNumber", m_pPlayerState->m_PlayerNumber );
 	msg.SetParam( "MultiPlayer", m_pPlayerState->m_mp );
 	msg.SetParam( "ToastyCombo", m_cur_toasty_combo );
-	MESSAGEMAN->Broadcast( msg );
+	if( m_bSendMessages )
+		MESSAGEMAN->Broadcast( msg );
 }
 
 
@@ -634,7 +639,8 @@ void ScoreKeeperNormal::HandleHoldScore( const TapNote &tn )
 	Message msg( "ScoreChanged" );
 	msg.SetParam( "PlayerNumber", m_pPlayerState->m_PlayerNumber );
 	msg.SetParam( "MultiPlayer", m_pPlayerState->m_mp );
-	MESSAGEMAN->Broadcast( msg );
+	if( m_bSendMessages )
+		MESSAGEMAN->Broadcast( msg );
 }
 
 
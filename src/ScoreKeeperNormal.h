@@ -38,6 +38,7 @@ class ScoreKeeperNormal: public ScoreKeeper
 	bool	m_bIsBeginner;
 
 	int	m_iNumNotesHitThisRow;	// Used by Custom Scoring only
+	bool	m_bSendMessages;
 
 	ThemeMetric<bool>		m_ComboIsPerRow;
 	ThemeMetric<bool>		m_MissComboIsPerRow;
@@ -70,6 +71,10 @@ public:
 		const std::vector<Steps*>& apSteps,
 		const std::vector<AttackArray> &asModifiers );
 
+	/* If false, nothing is broadcast or posted to the screen, and toasties
+	 * aren't awarded.  Replays use this to score without the theme seeing. */
+	void SetSendMessages( bool b ) { m_bSendMessages = b; }
+
 	// before a song plays (called multiple times if course)
 	void OnNextSong( int iSongInCourseIndex, const Steps* pSteps, const NoteData* pNoteData );
 
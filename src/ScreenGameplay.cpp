@@ -97,6 +97,11 @@ AutoScreenMessage( SM_BattleTrickLevel3 );
 static Preference<bool> g_bCenter1Player( "Center1Player", false );
 static Preference<bool> g_bShowLyrics( "ShowLyrics", true );
 static Preference<bool> g_bEasterEggs( "EasterEggs", true );
+/* If nonzero, judgment, hold and life logic runs at least this many times per
+ * second of song time, even if frames take longer than that. */
+static Preference<float> g_fGameplayLogicHz( "GameplayLogicHz", 0 );
+/* Don't let a long hitch turn into an unbounded amount of catching up. */
+static const int MAX_LOGIC_SUBSTEPS_PER_UPDATE = 250;
 
 
 PlayerInfo::PlayerInfo(): m_pn(PLAYER_INVALID), m_mp(MultiPlayer_Invalid),
@@ -1354,6 +1359,7 @@ void ScreenGameplay::LoadNextSong()
 	/* Give SoundEffectControls the new RageSoundReaders. */
 	FOREACH_EnabledPlayerInfo( m_vPlayerInfo, pi )
 	{
+		pi->m_pPlayer->SetMusicClock( m_pSoundMusic );
 		RageSoundReader *pPlayerSound = m_AutoKeysounds.GetPlayerSound(pi->m_pn);
 		if( pPlayerSound == nullptr && pi->m_pn == GAMESTATE->GetMasterPlayerNumber() )
 			pPlayerSound = m_AutoKeysounds.GetSharedSound();
@@ -1574,6 +1580,39 @@ void ScreenGameplay::UpdateSongPosition( float fDeltaTime )
 	GAMESTATE->UpdateSongPosition( fSeconds+fAdjust, GAMESTATE->m_pCurSong->m_SongTiming, tm+fAdjust );
 }
 
+/* When a frame takes longer than the logic rate allows, walk the players'
+ * judgment logic through the song positions in between, so misses, hold
+ * checkpoints and life changes happen in the order and at the song times
+ * they would have without the hitch.  The regular update then handles the
+ * current position. */
+void ScreenGameplay::UpdateGameplayLogicSubsteps( float fDeltaTime )
+{
+	if( g_fGameplayLogicHz <= 0 || m_bPaused || !m_pSoundMusic->IsPlaying() )
+		return;
+
+	const float fStep = 1.0f / g_fGameplayLogicHz;
+	const int iSteps = std::min( int(fDeltaTime / fStep), MAX_LOGIC_SUBSTEPS_PER_UPDATE );
+	if( iSteps < 2 )
+		return;
+
+	RageTimer tm;
+	const float fSeconds = m_pSoundMusic->GetPositionSeconds( nullptr, &tm );
+	const float fPlaybackRate = m_pSoundMusic->GetPlaybackRate();
+	const float fTweenRate = PREFSMAN->m_bRateModsAffectTweens ? GAMESTATE->m_SongOptions.GetCurrent().m_fMusicRate : 1.0f;
+	const float fSubstepDelta = fDeltaTime / iSteps;
+
+	// The last substep is the current position, which the regular update covers.
+	for( int i = 1; i < iSteps; ++i )
+	{
+		const float fSecondsAgo = fDeltaTime - i * fSubstepDelta;
+		const RageTimer tmSubstep = tm - fSecondsAgo;
+		GAMESTATE->UpdateSongPosition( fSeconds - fSecondsAgo * fPlaybackRate, GAMESTATE->m_pCurSong->m_SongTiming, tmSubstep );
+
+		FOREACH_EnabledPlayerInfo( m_vPlayerInfo, pi )
+			pi->m_pPlayer->UpdateLogicSubstep( fSubstepDelta * fTweenRate, tmSubstep );
+	}
+}
+
 void ScreenGameplay::BeginScreen()
 {
 	if( GAMESTATE->m_pCurSong == nullptr  )
@@ -1646,6 +1685,8 @@ void ScreenGameplay::Update( float fDeltaTime )
 		return;
 	}
 
+	if( !m_bZeroDeltaOnNextUpdate )
+		UpdateGameplayLogicSubsteps( fDeltaTime );
 	UpdateSongPosition( fDeltaTime );
 
 	if( m_bZeroDeltaOnNextUpdate )
@@ -230,6 +230,7 @@ protected:
 
 	void PlayTicks();
 	void UpdateSongPosition( float fDeltaTime );
+	void UpdateGameplayLogicSubsteps( float fDeltaTime );
 	void UpdateLyrics( float fDeltaTime );
 	void SongFinished();
 	virtual void SaveStats();
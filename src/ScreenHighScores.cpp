@@ -187,12 +187,20 @@ void ScoreScroller::Load( RString sMetricsGroup )
 	SCROLLER_SECONDS_PER_ITEM.Load(sMetricsGroup, "ScrollerSecondsPerItem");
 
 
+	/* An image or sprite item is loaded once and copied.  Lua items keep
+	 * their state in their own closures, so each one is made separately. */
 	int iNumCopies = SCROLLER_ITEMS_TO_DRAW+1;
+	const RString sItemPath = THEME->GetPathG(sMetricsGroup,"ScrollerItem");
+	const bool bCopy = ActorUtil::CanCopyActorFrom( sItemPath );
+	Actor *pFirst = nullptr;
 	for( int i=0; i<iNumCopies; ++i )
 	{
-		Actor *pActor = ActorUtil::MakeActor( THEME->GetPathG(sMetricsGroup,"ScrollerItem") );
-		if( pActor != nullptr )
-			this->AddChild( pActor );
+		Actor *pActor = (bCopy && pFirst)? pFirst->Copy():ActorUtil::MakeActor( sItemPath );
+		if( pActor == nullptr )
+			continue;
+		if( pFirst == nullptr )
+			pFirst = pActor;
+		this->AddChild( pActor );
 	}
 
 	DynamicActorScroller::SetTransformFromReference( THEME->GetMetricR(sMetricsGroup,"ScrollerItemTransformFunction") );
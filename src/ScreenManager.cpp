@@ -504,6 +504,8 @@ void ScreenManager::Draw()
 	if( !DISPLAY->BeginFrame() )
 		return;
 
+	Actor::ResetNumCulled();
+
 	DISPLAY->CameraPushMatrix();
 	DISPLAY->LoadMenuPerspective( 0, SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_CENTER_X, SCREEN_CENTER_Y );
 	g_pSharedBGA->Draw();
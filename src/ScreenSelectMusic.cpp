@@ -65,6 +65,8 @@ static bool g_bBannerWaiting = false;
 static bool g_bSampleMusicWaiting = false;
 static RageTimer g_StartedLoadingAt(RageZeroTimer);
 static RageTimer g_ScreenStartedLoadingAt(RageZeroTimer);
+/* How many songs on either side of the selection to decode sample music for. */
+static const int NUM_SAMPLE_MUSIC_PREFETCH = 2;
 RageTimer g_CanOpenOptionsList(RageZeroTimer);
 
 static LocalizedString PERMANENTLY_DELETE("ScreenSelectMusic", "PermanentlyDelete");
@@ -1982,6 +1984,8 @@ void ScreenSelectMusic::AfterMusicChange()
 
 	g_StartedLoadingAt.Touch();
 
+	PrefetchSampleMusic();
+
 	std::vector<PlayerNumber> vpns;
 	FOREACH_HumanPlayer( p )
 		vpns.push_back( p );
@@ -1989,6 +1993,44 @@ void ScreenSelectMusic::AfterMusicChange()
 	AfterStepsOrTrailChange( vpns );
 }
 
+/* Decode the sample music of the selected song and its neighbors in the
+ * background, so it's ready to start as soon as the wheel settles. */
+void ScreenSelectMusic::PrefetchSampleMusic()
+{
+	SOUND->ClearMusicPreviewPrefetches();
+
+	switch( SAMPLE_MUSIC_PREVIEW_MODE )
+	{
+	case SampleMusicPreviewMode_Normal:
+	case SampleMusicPreviewMode_StartToPreview:
+	case SampleMusicPreviewMode_LastSong:
+		break;
+	default:
+		return;
+	}
+
+	const int iNumItems = m_MusicWheel.GetNumItems();
+	if( iNumItems == 0 )
+		return;
+
+	/* The selection first, then outward in both directions. */
+	const int iCurrent = m_MusicWheel.GetCurrentIndex();
+	for( int i = 0; i <= NUM_SAMPLE_MUSIC_PREFETCH*2 && i < iNumItems; ++i )
+	{
+		const int iOffset = (i % 2)? (i+1)/2 : -(i/2);
+		const int iIndex = ((iCurrent + iOffset) % iNumItems + iNumItems) % iNumItems;
+		const MusicWheelItemData *pData = m_MusicWheel.GetCurWheelItemData( iIndex );
+		if( pData->m_Type != WheelItemDataType_Song || pData->m_pSong == nullptr )
+			continue;
+
+		const Song *pSong = pData->m_pSong;
+		const RString sPath = pSong->GetPreviewMusicPath();
+		if( sPath.empty() || ActorUtil::GetFileType(sPath) != FT_Sound )
+			continue;
+		SOUND->PrefetchMusicPreview( sPath, pSong->GetPreviewStartSeconds(), pSong->m_fMusicSampleLengthSeconds );
+	}
+}
+
 void ScreenSelectMusic::OpenOptionsList(PlayerNumber pn)
 {
 	if( pn != PLAYER_INVALID )
@@ -67,6 +67,7 @@ protected:
 	void AfterStepsOrTrailChange( const std::vector<PlayerNumber> &vpns );
 	void SwitchToPreferredDifficulty();
 	void AfterMusicChange();
+	void PrefetchSampleMusic();
 
 	void CheckBackgroundRequests( bool bForce );
 	bool DetectCodes( const InputEventPlus &input );
@@ -4,6 +4,7 @@
 #include "PrefsManager.h"
 #include "RageDisplay.h"
 #include "RageLog.h"
+#include "LuaManager.h"
 #include "ScreenDimensions.h"
 
 REGISTER_SCREEN_CLASS( ScreenStatsOverlay );
@@ -77,7 +78,8 @@ void ScreenStatsOverlay::Update( float fDeltaTime )
 	this->SetVisible( PREFSMAN->m_bShowStats );
 	if( PREFSMAN->m_bShowStats )
 	{
-		m_textStats.SetText( DISPLAY->GetStats() );
+		m_textStats.SetText( DISPLAY->GetStats() + "\n" + LUA->GetGarbageCollectorStats() +
+			ssprintf("\n%i culled", Actor::GetNumCulled()) );
 		if ( SHOW_SKIPS )
 			UpdateSkips();
 	}
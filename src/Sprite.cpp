@@ -670,6 +670,15 @@ bool Sprite::EarlyAbortDraw() const
 	return m_pTexture == nullptr;
 }
 
+bool Sprite::GetLocalDrawBounds( RectF &rectOut ) const
+{
+	// Custom coordinates and the shadow both draw outside the quad.
+	if( m_bUsingCustomPosCoords || m_fShadowLengthX != 0 || m_fShadowLengthY != 0 )
+		return false;
+	rectOut = RectF( -m_size.x/2.0f, -m_size.y/2.0f, +m_size.x/2.0f, +m_size.y/2.0f );
+	return true;
+}
+
 void Sprite::DrawPrimitives()
 {
 	if( m_pTempState->fade.top > 0 ||
@@ -36,6 +36,7 @@ public:
 	virtual Sprite *Copy() const override;
 
 	virtual bool EarlyAbortDraw() const override;
+	virtual bool GetLocalDrawBounds( RectF &rectOut ) const override;
 	virtual void DrawPrimitives() override;
 	virtual void Update( float fDeltaTime ) override;
 
@@ -80,6 +81,7 @@ public:
 	void StretchTexCoords( float fX, float fY );
 	void AddImageCoords( float fX, float fY ); // in image pixel space
 	void SetEffectMode( EffectMode em ) { m_EffectMode = em; }
+	EffectMode GetEffectMode() const { return m_EffectMode; }
 
 	void LoadFromCached( const RString &sDir, const RString &sPath );
 
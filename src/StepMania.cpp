@@ -29,6 +29,7 @@
 #include "RageSurface.h"
 #include "RageSurface_Load.h"
 #include "CommandLineActions.h"
+#include "ChartReplay.h"
 
 #if !defined(SUPPORT_OPENGL) && !defined(SUPPORT_D3D)
 #define SUPPORT_OPENGL
@@ -977,6 +978,8 @@ int sm_main(int argc, char* argv[])
 
 	if( PREFSMAN->m_iSoundWriteAhead )
 		LOG->Info( "Sound writeahead has been overridden to %i", PREFSMAN->m_iSoundWriteAhead.Get() );
+	if( PREFSMAN->m_bSoundLowLatency )
+		LOG->Info( "Low-latency sound mode is enabled" );
 
 	SOUNDMAN	= new RageSoundManager;
 	SOUNDMAN->Init();
@@ -1039,6 +1042,13 @@ int sm_main(int argc, char* argv[])
 
 	StepMania::ResetGame();
 
+	// --replay=<file> scores replays and exits instead of starting the game.
+	if( ChartReplay::HandleCommandLine() )
+	{
+		ShutdownGame();
+		return 0;
+	}
+
 	/* Now that GAMESTATE is reset, tell SCREENMAN to update the theme (load
 	 * overlay screens and global sounds), and load the initial screen. */
 	SCREENMAN->ThemeChanged();
@@ -28,7 +28,9 @@
 #include "XmlFileUtil.h"
 
 #include <cstddef>
+#include <cstdlib>
 #include <deque>
+#include <map>
 #include <vector>
 
 
@@ -53,15 +55,36 @@ struct Theme
 };
 // When looking for a metric or an element, search these from head to tail.
 static std::deque<Theme> g_vThemes;
+
+/* A metric with its fallback groups already resolved.  Values that are plain
+ * numbers or booleans are parsed here, so pushing them doesn't run Lua. */
+struct CompiledMetric
+{
+	enum Type { EXPRESSION, NUMBER, BOOLEAN };
+
+	bool m_bFound;
+	RString m_sValue;
+	Type m_Type;
+	double m_fNumber;
+};
+
 class LoadedThemeData
 {
 public:
 	IniFile iniMetrics;
 	IniFile iniStrings;
+	/* These are filled in as metrics are first looked up, so each lookup walks
+	 * the fallback groups once per load.  They aren't built when the ini is
+	 * loaded, because Fallback expressions can call functions from theme
+	 * scripts that haven't run yet at that point. */
+	std::map<RString,RString> mapGroupToFallback;
+	std::map<RString,CompiledMetric> mapCompiledMetrics;
 	void ClearAll()
 	{
 		iniMetrics.Clear();
 		iniStrings.Clear();
+		mapGroupToFallback.clear();
+		mapCompiledMetrics.clear();
 	}
 };
 LoadedThemeData *g_pLoadedThemeData = nullptr;
@@ -946,21 +969,91 @@ RString ThemeManager::GetMetricsGroupFallback( const RString &sMetricsGroup )
 {
 	ASSERT( g_pLoadedThemeData != nullptr );
 
+	std::map<RString,RString>::const_iterator it = g_pLoadedThemeData->mapGroupToFallback.find( sMetricsGroup );
+	if( it != g_pLoadedThemeData->mapGroupToFallback.end() )
+		return it->second;
+
 	// always look in iniMetrics for "Fallback"
 	RString sFallback;
-	if( !GetMetricRawRecursive(g_pLoadedThemeData->iniMetrics,sMetricsGroup,"Fallback",sFallback) )
-		return RString();
-
-	Lua *L = LUA->Get();
-	LuaHelpers::RunExpression( L, sFallback );
 	RString sRet;
-	LuaHelpers::Pop( L, sRet );
-	LUA->Release( L );
+	if( FindMetricRaw(g_pLoadedThemeData->iniMetrics,sMetricsGroup,"Fallback",sFallback) )
+	{
+		Lua *L = LUA->Get();
+		LuaHelpers::RunExpression( L, sFallback );
+		LuaHelpers::Pop( L, sRet );
+		LUA->Release( L );
+	}
 
+	g_pLoadedThemeData->mapGroupToFallback[sMetricsGroup] = sRet;
 	return sRet;
 }
 
-bool ThemeManager::GetMetricRawRecursive( const IniFile &ini, const RString &sMetricsGroup_, const RString &sValueName, RString &sOut )
+static void CompileMetricValue( const RString &sValueName, CompiledMetric &metric )
+{
+	metric.m_Type = CompiledMetric::EXPRESSION;
+	metric.m_fNumber = 0;
+	if( EndsWith(sValueName, "Command") )
+		return;
+
+	const RString &s = metric.m_sValue;
+	if( s == "true" || s == "false" )
+	{
+		metric.m_Type = CompiledMetric::BOOLEAN;
+		metric.m_fNumber = s == "true";
+		return;
+	}
+
+	// Only plain decimals, with an optional sign.  Anything else, including
+	// hex and exponents, is left to Lua.
+	std::size_t i = 0;
+	if( i < s.size() && (s[i] == '-' || s[i] == '+') )
+		++i;
+	bool bDigits = false, bPoint = false;
+	for( ; i < s.size(); ++i )
+	{
+		if( s[i] >= '0' && s[i] <= '9' )
+			bDigits = true;
+		else if( s[i] == '.' && !bPoint )
+			bPoint = true;
+		else
+			return;
+	}
+	if( !bDigits )
+		return;
+
+	metric.m_Type = CompiledMetric::NUMBER;
+	metric.m_fNumber = std::strtod( s.c_str(), nullptr );
+}
+
+const CompiledMetric *ThemeManager::GetCompiledMetric( const RString &sMetricsGroup, const RString &sValueName )
+{
+	ASSERT( g_pLoadedThemeData != nullptr );
+
+	const RString sKey = sMetricsGroup + "::" + sValueName;
+	std::map<RString,CompiledMetric>::const_iterator it = g_pLoadedThemeData->mapCompiledMetrics.find( sKey );
+	if( it == g_pLoadedThemeData->mapCompiledMetrics.end() )
+	{
+		CompiledMetric metric;
+		metric.m_bFound = FindMetricRaw( g_pLoadedThemeData->iniMetrics, sMetricsGroup, sValueName, metric.m_sValue );
+		CompileMetricValue( sValueName, metric );
+		it = g_pLoadedThemeData->mapCompiledMetrics.insert( std::make_pair(sKey, metric) ).first;
+	}
+	return it->second.m_bFound ? &it->second : nullptr;
+}
+
+bool ThemeManager::GetMetricRawRecursive( const IniFile &ini, const RString &sMetricsGroup, const RString &sValueName, RString &sOut )
+{
+	if( &ini != &g_pLoadedThemeData->iniMetrics )
+		return FindMetricRaw( ini, sMetricsGroup, sValueName, sOut );
+
+	const CompiledMetric *pMetric = GetCompiledMetric( sMetricsGroup, sValueName );
+	if( pMetric == nullptr )
+		return false;
+	sOut = pMetric->m_sValue;
+	return true;
+}
+
+bool ThemeManager::FindMetricRaw( const IniFile &ini, const RString &sMetricsGroup_, const RString &sValueName, RString &sOut )
 {
 	ASSERT( sValueName != "" );
 	RString sMetricsGroup( sMetricsGroup_ );
@@ -1104,7 +1197,20 @@ void ThemeManager::PushMetric( Lua *L, const RString &sMetricsGroup, const RStri
 		lua_pushnil(L);
 		return;
 	}
-	RString sValue = GetMetricRaw( g_pLoadedThemeData->iniMetrics, sMetricsGroup, sValueName );
+	const CompiledMetric *pMetric = GetCompiledMetric( sMetricsGroup, sValueName );
+	if( pMetric != nullptr && pMetric->m_Type == CompiledMetric::NUMBER )
+	{
+		lua_pushnumber( L, pMetric->m_fNumber );
+		return;
+	}
+	if( pMetric != nullptr && pMetric->m_Type == CompiledMetric::BOOLEAN )
+	{
+		lua_pushboolean( L, pMetric->m_fNumber != 0 );
+		return;
+	}
+
+	// If the metric is missing, GetMetricRaw reports it.
+	RString sValue = pMetric != nullptr ? pMetric->m_sValue : GetMetricRaw( g_pLoadedThemeData->iniMetrics, sMetricsGroup, sValueName );
 
 	RString sName = ssprintf( "%s::%s", sMetricsGroup.c_str(), sValueName.c_str() );
 	if( EndsWith(sValueName, "Command") )
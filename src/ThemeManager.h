@@ -28,6 +28,7 @@ const RString& ElementCategoryToString( ElementCategory ec );
 ElementCategory StringToElementCategory( const RString& s );
 
 struct Theme;
+struct CompiledMetric;
 /** @brief Manages theme paths and metrics. */
 class ThemeManager
 {
@@ -116,6 +117,8 @@ protected:
 	void LoadThemeMetrics( const RString &sThemeName, const RString &sLanguage_ );
 	RString GetMetricRaw( const IniFile &ini, const RString &sMetricsGroup, const RString &sValueName );
 	bool GetMetricRawRecursive( const IniFile &ini, const RString &sMetricsGroup, const RString &sValueName, RString &sRet );
+	bool FindMetricRaw( const IniFile &ini, const RString &sMetricsGroup, const RString &sValueName, RString &sRet );
+	const CompiledMetric *GetCompiledMetric( const RString &sMetricsGroup, const RString &sValueName );
 
 	bool GetPathInfoToAndFallback( PathInfo &out, ElementCategory category, const RString &sMetricsGroup, const RString &sFile );
 	bool GetPathInfoToRaw( PathInfo &out, const RString &sThemeName, ElementCategory category, const RString &sMetricsGroup, const RString &sFile );
@@ -7,6 +7,7 @@
 #include "ThemeManager.h"
 #include "NoteTypes.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <cstddef>
@@ -52,6 +53,7 @@ void TimingData::Clear()
 
 		vSegs.clear();
 	}
+	m_displayed_beat_lookup.clear();
 }
 
 bool TimingData::IsSafeFullTiming()
@@ -122,6 +124,25 @@ void TimingData::PrepareLookup()
 	// DumpLookupTables();
 }
 
+void TimingData::PrepareDisplayedBeatLookup() const
+{
+	const std::vector<TimingSegment*>& scrolls= m_avpTimingSegments[SEGMENT_SCROLL];
+	m_displayed_beat_lookup.clear();
+	m_displayed_beat_lookup.reserve(scrolls.size());
+	float displayed_beat= 0.0f;
+	float last_real_beat= 0.0f;
+	float last_ratio= 1.0f;
+	for(std::size_t i= 0; i < scrolls.size(); ++i)
+	{
+		const ScrollSegment* seg= ToScroll(scrolls[i]);
+		displayed_beat+= (seg->GetBeat() - last_real_beat) * last_ratio;
+		last_real_beat= seg->GetBeat();
+		last_ratio= seg->GetRatio();
+		displayed_beat_entry_t entry= {seg->GetBeat(), displayed_beat, seg->GetRatio()};
+		m_displayed_beat_lookup.push_back(entry);
+	}
+}
+
 void TimingData::ReleaseLookup()
 {
 	// According to The C++ Programming Language 3rd Ed., decreasing the size
@@ -138,6 +159,61 @@ void TimingData::ReleaseLookup()
 #undef CLEAR_LOOKUP
 }
 
+float TimingData::GetDisplayedBeat(float beat, std::size_t& cursor) const
+{
+	const displayed_beat_lookup_t& lookup= m_displayed_beat_lookup;
+	if(lookup.empty())
+	{
+		PrepareDisplayedBeatLookup();
+		if(lookup.empty())
+		{
+			return beat;
+		}
+	}
+
+	// The entry to use is the last one that starts at or before the beat, or
+	// the first one if the beat is before all of them.
+	const std::size_t last= lookup.size() - 1;
+	std::size_t index= std::min(cursor, last);
+	// Lookups that follow the last one closely only step a few entries.  If
+	// the beat is farther away than that, a binary search is faster.
+	const int max_steps= 8;
+	int steps= 0;
+	while(steps < max_steps && index < last && lookup[index+1].beat <= beat)
+	{
+		++index;
+		++steps;
+	}
+	while(steps < max_steps && index > 0 && lookup[index].beat > beat)
+	{
+		--index;
+		++steps;
+	}
+	const bool after_start= index == 0 || lookup[index].beat <= beat;
+	const bool before_end= index == last || beat < lookup[index+1].beat;
+	if(!after_start || !before_end)
+	{
+		std::size_t lower= 0;
+		std::size_t upper= lookup.size();
+		while(lower < upper)
+		{
+			std::size_t mid= (lower + upper) / 2;
+			if(lookup[mid].beat <= beat)
+			{
+				lower= mid + 1;
+			}
+			else
+			{
+				upper= mid;
+			}
+		}
+		index= lower > 0 ? lower - 1 : 0;
+	}
+	cursor= index;
+	const displayed_beat_entry_t& entry= lookup[index];
+	return entry.displayed_beat + entry.velocity * (beat - entry.beat);
+}
+
 RString SegInfoStr(const std::vector<TimingSegment*>& segs, unsigned int index, const RString& name)
 {
 	if(index < segs.size())
@@ -603,6 +679,8 @@ void TimingData::AddSegment( const TimingSegment *seg )
 
 	TimingSegmentType tst = seg->GetType();
 	std::vector<TimingSegment*> &vSegs = m_avpTimingSegments[tst];
+	if( tst == SEGMENT_SCROLL )
+		m_displayed_beat_lookup.clear();
 
 	// OPTIMIZATION: if this is our first segment, push and return.
 	if( vSegs.empty() )
@@ -7,6 +7,7 @@
 
 #include <array>
 #include <cfloat>
+#include <cstddef>
 #include <vector>
 
 
@@ -130,6 +131,28 @@ public:
 	beat_start_lookup_t m_beat_start_lookup;
 	beat_start_lookup_t m_time_start_lookup;
 
+	// The displayed beat is the beat with scroll segments applied, which is
+	// what note positions are based on.  m_displayed_beat_lookup holds the
+	// displayed beat and velocity at the start of each scroll segment, so
+	// GetDisplayedBeat doesn't have to add up the segments every time.  It's
+	// separate from the lookups above and isn't freed by ReleaseLookup.
+	// Player::Load rebuilds it, and GetDisplayedBeat builds it if it's
+	// missing, so NoteFields outside of gameplay use it too.
+	// The cursor is the index of the entry the last lookup ended on.  Callers
+	// keep one for each series of lookups that moves in order (the song
+	// position, or the notes of a column from near to far), so each lookup
+	// only has to step over the entries between it and the last one.
+	struct displayed_beat_entry_t
+	{
+		float beat;
+		float displayed_beat;
+		float velocity;
+	};
+	typedef std::vector<displayed_beat_entry_t> displayed_beat_lookup_t;
+	mutable displayed_beat_lookup_t m_displayed_beat_lookup;
+	void PrepareDisplayedBeatLookup() const;
+	float GetDisplayedBeat(float beat, std::size_t& cursor) const;
+
 	void PrepareLookup();
 	void ReleaseLookup();
 	void DumpOneTable(const beat_start_lookup_t& lookup, const RString& name);
@@ -71,6 +71,8 @@ bool Alsa9Buf::SetHWParams()
 	err = dsnd_pcm_hw_params( pcm, hwparams );
 	ALSA_CHECK("dsnd_pcm_hw_params");
 
+	fill_target = writeahead;
+
 	return true;
 }
 
@@ -217,6 +219,8 @@ Alsa9Buf::Alsa9Buf()
 	last_cursor_pos = 0;
 	preferred_writeahead = 8192;
 	preferred_chunksize = 1024;
+	fill_target = 0;
+	underruns = 0;
 	pcm = nullptr;
 }
 
@@ -275,7 +279,7 @@ int Alsa9Buf::GetNumFramesToFill()
 {
 	/* Make sure we can write ahead at least two chunks.  Otherwise, we'll only
 	 * fill one chunk ahead, and underrun. */
-	int ActualWriteahead = std::max( writeahead, chunksize*2 );
+	int ActualWriteahead = std::max( fill_target, chunksize*2 );
 
 	snd_pcm_sframes_t avail_frames = dsnd_pcm_avail_update(pcm);
 
@@ -285,6 +289,7 @@ int Alsa9Buf::GetNumFramesToFill()
 		/* underrun */
 		const int size = avail_frames-total_frames;
 		LOG->Trace("underrun (%i frames)", size);
+		++underruns;
 		int large_skip_threshold = 2 * samplerate;
 
 		/* For small underruns, ignore them.  We'll return the maximum writeahead and ALSA will
@@ -403,6 +408,11 @@ std::int64_t Alsa9Buf::GetPosition() const
 	return last_cursor_pos - delay;
 }
 
+void Alsa9Buf::SetFillTarget( int iFrames )
+{
+	fill_target = clamp( (snd_pcm_uframes_t) iFrames, chunksize*2, std::max(writeahead, chunksize*2) );
+}
+
 void Alsa9Buf::Play()
 {
 	/* NOP.  It'll start playing when it gets some data. */
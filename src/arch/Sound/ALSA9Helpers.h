@@ -18,6 +18,13 @@ private:
 	snd_pcm_uframes_t preferred_writeahead, preferred_chunksize;
 	snd_pcm_uframes_t writeahead, chunksize;
 
+	/* The most we'll keep buffered, which may be less than the hardware buffer
+	 * size (writeahead).  Only the mixing thread changes this. */
+	snd_pcm_uframes_t fill_target;
+
+	/* The number of times the buffer has run dry. */
+	int underruns;
+
 	snd_pcm_t *pcm;
 
 	bool Recover( int r );
@@ -49,6 +56,13 @@ public:
 
 	std::int64_t GetPosition() const;
 	std::int64_t GetPlayPos() const { return last_cursor_pos; }
+
+	/* Keep no more than iFrames buffered, to reduce latency.  This is clamped
+	 * to between two periods and the hardware buffer size. */
+	void SetFillTarget( int iFrames );
+	int GetFillTarget() const { return fill_target; }
+	int GetChunkSize() const { return chunksize; }
+	int GetUnderrunCount() const { return underruns; }
 };
 #endif
 
@@ -7,6 +7,7 @@
 #include "RageTimer.h"
 #include "RageUtil_CircularBuffer.h"
 
+#include <atomic>
 #include <cstdint>
 
 class RageSoundBase;
@@ -67,6 +68,13 @@ public:
 	 * hearing it.  (This isn't necessarily the same as the buffer latency.) */
 	virtual float GetPlayLatency() const { return 0.0f; }
 
+	/* Measured output latency, in frames, that GetPosition() doesn't already
+	 * account for: the delay between a frame being at GetPosition() and it
+	 * actually being heard.  GetHardwareFrame() subtracts this, so sound
+	 * positions, and through them song timing, include the device latency
+	 * without the global offset having to be tuned by hand. */
+	virtual std::int64_t GetOutputLatencyFrames() const { return 0; }
+
 	virtual int GetSampleRate() const { return 44100; }
 
 protected:
@@ -104,18 +112,15 @@ protected:
 
 private:
 	/* This mutex is used for serializing with the decoder thread.  Locking this mutex
-	 * can take a while. */
+	 * can take a while.  The mixing thread never takes it. */
 	RageMutex m_Mutex;
 
-	/* This mutex locks all sounds[] which are "available".  (Other sound may safely
-	 * be accessed, and sounds may be set to available, without locking this.) */
-	RageMutex m_SoundListMutex;
-
 	/*
 	 * Thread safety and state transitions:
 	 *
 	 * AVAILABLE: The sound is available to play a new sound. The decoding and mixing threads
-	 * will not touch a sound in this state.
+	 * will not touch a sound in this state.  StartMixing() claims a slot by moving it from
+	 * AVAILABLE to BUFFERING with a compare-and-swap, so no lock is needed to reserve one.
 	 *
 	 * BUFFERING: The sound is stopped but StartMixing() is prebuffering. No other threads
 	 * will touch a sound that is BUFFERING. This isn't necessary if only the main thread
@@ -149,6 +154,14 @@ private:
 	 * The only state change made by the mixing thread is from HALTING to STOPPED.
 	 * This is done with no locks; no other thread can take a sound out of the HALTING state.
 	 *
+	 * m_State is atomic.  A thread that hands a sound to another thread (eg. StartMixing
+	 * setting PLAYING, or the mixer setting STOPPED) stores the new state with release
+	 * semantics after it's done touching the sound, and the receiving thread loads it
+	 * with acquire semantics, so everything written before the transition is visible.
+	 * The sample data itself is handed from the decoding thread to the mixing thread
+	 * through m_Buffer, and positions back through m_PosMapQueue; both are single-producer,
+	 * single-consumer ring buffers, so neither side ever waits on the other.
+	 *
 	 * Do not allocate or deallocate memory in the mixing thread since allocating memory
 	 * involves taking a lock. Instead, push the deallocation to the main thread.
 	 */
@@ -172,7 +185,7 @@ private:
 		RageTimer m_StartTime;
 		CircBuf<sound_block> m_Buffer;
 
-		bool m_bPaused;
+		std::atomic<bool> m_bPaused;
 
 		struct QueuedPosMap
 		{
@@ -183,7 +196,7 @@ private:
 
 		CircBuf<QueuedPosMap> m_PosMapQueue;
 
-		enum
+		enum State
 		{
 			AVAILABLE,
 			BUFFERING,
@@ -196,7 +209,17 @@ private:
 
 			HALTING,	/* stop immediately */
 			PLAYING
-		} m_State;
+		};
+		std::atomic<State> m_State;
+
+		State GetState() const { return m_State.load( std::memory_order_acquire ); }
+		void SetState( State s ) { m_State.store( s, std::memory_order_release ); }
+		/* Change the state from eFrom to eTo, if it's still eFrom.  Return true if the
+		 * state was changed. */
+		bool ChangeState( State eFrom, State eTo )
+		{
+			return m_State.compare_exchange_strong( eFrom, eTo, std::memory_order_acq_rel );
+		}
 	};
 
 	/* List of currently playing sounds: XXX no vector */
@@ -207,6 +230,10 @@ private:
 	mutable std::int64_t m_iVMaxHardwareFrame;
 	mutable std::int32_t soundDriverMaxSamples = 0;
 
+	/* GetPosition(), less the measured output latency. */
+	std::int64_t GetAudiblePosition() const;
+	std::int64_t m_iLoggedLatencyFrames;
+
 	bool m_bShutdownDecodeThread;
 
 	static int DecodeThread_start( void *p );
@@ -28,6 +28,13 @@ static const unsigned safe_writeahead = 1024*4;
 static unsigned g_iMaxWriteahead;
 const int num_chunks = 8;
 
+/* In low-latency mode, allocate a hardware buffer large enough to ride out a
+ * scheduling hiccup, but only keep a couple of small periods of it filled.
+ * The fill level grows by a period each time we underrun, so it settles at
+ * the smallest level this machine can sustain. */
+static const unsigned low_latency_buffer = 1024*4;
+static const unsigned low_latency_period = 64;
+
 int RageSoundDriver_ALSA9_Software::MixerThread_start( void *p )
 {
 	((RageSoundDriver_ALSA9_Software *) p)->MixerThread();
@@ -43,6 +50,9 @@ void RageSoundDriver_ALSA9_Software::MixerThread()
 		while( !m_bShutdown && GetData() )
 			;
 
+		if( PREFSMAN->m_bSoundLowLatency )
+			AdjustLowLatencyFillTarget();
+
 		m_pPCM->WaitUntilFramesCanBeFilled( 100 );
 	}
 }
@@ -77,6 +87,23 @@ bool RageSoundDriver_ALSA9_Software::GetData()
 }
 
 
+void RageSoundDriver_ALSA9_Software::AdjustLowLatencyFillTarget()
+{
+	const int iUnderruns = m_pPCM->GetUnderrunCount();
+	if( iUnderruns == m_iHandledUnderruns )
+		return;
+	m_iHandledUnderruns = iUnderruns;
+
+	const int iOldTarget = m_pPCM->GetFillTarget();
+	m_pPCM->SetFillTarget( iOldTarget + m_pPCM->GetChunkSize() );
+	if( m_pPCM->GetFillTarget() != iOldTarget )
+		LOG->Trace( "ALSA low-latency: underrun; raising fill target from %i to %i frames",
+			iOldTarget, m_pPCM->GetFillTarget() );
+}
+
+/* GetPosition comes from snd_pcm_delay, which already includes the latency
+ * of the device (and, through the ALSA plugin, of a PipeWire or PulseAudio
+ * graph), so there's no separate output latency to report. */
 std::int64_t RageSoundDriver_ALSA9_Software::GetPosition() const
 {
 	return m_pPCM->GetPosition();
@@ -92,6 +119,7 @@ RageSoundDriver_ALSA9_Software::RageSoundDriver_ALSA9_Software()
 {
 	m_pPCM = nullptr;
 	m_bShutdown = false;
+	m_iHandledUnderruns = 0;
 }
 
 RString RageSoundDriver_ALSA9_Software::Init()
@@ -111,14 +139,31 @@ RString RageSoundDriver_ALSA9_Software::Init()
 	if( PREFSMAN->m_iSoundWriteAhead )
 		g_iMaxWriteahead = PREFSMAN->m_iSoundWriteAhead;
 
+	unsigned iBufferSize = g_iMaxWriteahead;
+	unsigned iChunkSize = g_iMaxWriteahead / num_chunks;
+	if( PREFSMAN->m_bSoundLowLatency )
+	{
+		iBufferSize = std::max( low_latency_buffer, g_iMaxWriteahead );
+		iChunkSize = low_latency_period;
+	}
+
 	m_pPCM = new Alsa9Buf();
 	sError = m_pPCM->Init( channels,
-			g_iMaxWriteahead,
-			g_iMaxWriteahead / num_chunks,
+			iBufferSize,
+			iChunkSize,
 			PREFSMAN->m_iSoundPreferredSampleRate );
 	if( sError != "" )
 		return sError;
 
+	if( PREFSMAN->m_bSoundLowLatency )
+	{
+		/* Start at the smallest fill level; the mixing thread backs off from here
+		 * on underruns.  If SoundWriteAhead is set, start there instead. */
+		m_pPCM->SetFillTarget( PREFSMAN->m_iSoundWriteAhead );
+		LOG->Info( "ALSA low-latency mode: %i-frame periods, filling %i frames",
+			m_pPCM->GetChunkSize(), m_pPCM->GetFillTarget() );
+	}
+
 	m_iSampleRate = m_pPCM->GetSampleRate();
 
 	StartDecodeThread();
@@ -147,6 +192,8 @@ RageSoundDriver_ALSA9_Software::~RageSoundDriver_ALSA9_Software()
 
 float RageSoundDriver_ALSA9_Software::GetPlayLatency() const
 {
+	if( PREFSMAN->m_bSoundLowLatency )
+		return float(m_pPCM->GetFillTarget()) / m_iSampleRate;
 	return float(g_iMaxWriteahead) / m_iSampleRate;
 }
 
@@ -29,6 +29,10 @@ private:
 
 	bool m_bShutdown;
 	int m_iSampleRate;
+
+	/* Low-latency mode: underruns we've already raised the fill target for. */
+	int m_iHandledUnderruns;
+	void AdjustLowLatencyFillTarget();
 	Alsa9Buf *m_pPCM;
 	RageThread m_MixingThread;
 };
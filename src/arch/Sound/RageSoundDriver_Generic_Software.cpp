@@ -7,6 +7,7 @@
 #include "RageSoundMixBuffer.h"
 #include "RageSoundReader.h"
 
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 
@@ -17,13 +18,15 @@ static int frames_to_buffer;
 /* 512 is about 10ms, which is big enough for the tolerance of most schedulers. */
 static int chunksize() { return 512; }
 
-static int underruns = 0, logged_underruns = 0;
+/* Only the mixing thread increments underruns; Update() reads it. */
+static std::atomic<int> underruns( 0 );
+static int logged_underruns = 0;
 
 RageSoundDriver::Sound::Sound()
 {
 	m_pSound = nullptr;
-	m_State = AVAILABLE;
-	m_bPaused = false;
+	m_State.store( AVAILABLE, std::memory_order_relaxed );
+	m_bPaused.store( false, std::memory_order_relaxed );
 }
 
 void RageSoundDriver::Sound::Allocate( int iFrames )
@@ -67,21 +70,23 @@ RageSoundMixBuffer &RageSoundDriver::MixIntoBuffer( int iFrames, std::int64_t iF
 	{
 		/* s.m_pSound can not safely be accessed from here. */
 		Sound &s = m_Sounds[i];
-		if( s.m_State == Sound::HALTING )
+		const Sound::State eState = s.GetState();
+		if( eState == Sound::HALTING )
 		{
-			/* This indicates that this stream can be reused. */
-			s.m_bPaused = false;
-			s.m_State = Sound::STOPPED;
+			/* This indicates that this stream can be reused.  Nobody else can take
+			 * a sound out of HALTING, so this can't fail. */
+			s.m_bPaused.store( false, std::memory_order_relaxed );
+			s.ChangeState( Sound::HALTING, Sound::STOPPED );
 
 //			LOG->Trace("set %p from HALTING to STOPPED", m_Sounds[i].m_pSound);
 			continue;
 		}
 
-		if( s.m_State != Sound::STOPPING && s.m_State != Sound::PLAYING )
+		if( eState != Sound::STOPPING && eState != Sound::PLAYING )
 			continue;
 
 		/* STOPPING or PLAYING.  Read sound data. */
-		if( m_Sounds[i].m_bPaused )
+		if( s.m_bPaused.load( std::memory_order_relaxed ) )
 			continue;
 
 		int iGotFrames = 0;
@@ -154,8 +159,8 @@ RageSoundMixBuffer &RageSoundDriver::MixIntoBuffer( int iFrames, std::int64_t iF
 		}
 
 		/* If we don't have enough to fill the buffer, we've underrun. */
-		if( iGotFrames < iFrames && s.m_State == Sound::PLAYING )
-			++underruns;
+		if( iGotFrames < iFrames && eState == Sound::PLAYING )
+			underruns.fetch_add( 1, std::memory_order_relaxed );
 	}
 
 	return mix;
@@ -199,7 +204,7 @@ void RageSoundDriver::DecodeThread()
 
 		for( unsigned i = 0; i < ARRAYLEN(m_Sounds); ++i )
 		{
-			if( m_Sounds[i].m_State != Sound::PLAYING )
+			if( m_Sounds[i].GetState() != Sound::PLAYING )
 				continue;
 
 			Sound *pSound = &m_Sounds[i];
@@ -213,7 +218,7 @@ void RageSoundDriver::DecodeThread()
 				if( iWrote < 0 )
 				{
 					/* This sound is finishing. */
-					pSound->m_State = Sound::STOPPING;
+					pSound->ChangeState( Sound::PLAYING, Sound::STOPPING );
 					break;
 //					LOG->Trace("mixer: (#%i) eof (%p)", i, pSound->m_pSound );
 				}
@@ -265,11 +270,11 @@ void RageSoundDriver::Update()
 			}
 		}
 
-		switch( m_Sounds[i].m_State )
+		switch( m_Sounds[i].GetState() )
 		{
 		case Sound::STOPPED:
 			m_Sounds[i].Deallocate();
-			m_Sounds[i].m_State = Sound::AVAILABLE;
+			m_Sounds[i].SetState( Sound::AVAILABLE );
 			continue;
 		case Sound::STOPPING:
 			break;
@@ -288,7 +293,7 @@ void RageSoundDriver::Update()
 		/* This sound is done.  Set it to HALTING, since the mixer thread might
 		 * be accessing it; it'll change it back to STOPPED once it's ready to
 		 * be used again. */
-		m_Sounds[i].m_State = Sound::HALTING;
+		m_Sounds[i].SetState( Sound::HALTING );
 //		LOG->Trace("set (#%i) %p from STOPPING to HALTING", i, m_Sounds[i].m_pSound);
 	}
 
@@ -296,7 +301,7 @@ void RageSoundDriver::Update()
 	if( RageTimer::GetTimeSinceStart() >= fNext )
 	{
 		/* Lockless: only Mix() can write to underruns. */
-		int current_underruns = underruns;
+		int current_underruns = underruns.load( std::memory_order_relaxed );
 		if( current_underruns > logged_underruns )
 		{
 			LOG->MapLog( "GenericMixingUnderruns", "Mixing underruns: %i", current_underruns - logged_underruns );
@@ -309,30 +314,31 @@ void RageSoundDriver::Update()
 		}
 	}
 
+	/* Report the measured output latency when it changes by more than a
+	 * millisecond, so sync problems can be matched up with device changes. */
+	const std::int64_t iLatency = GetOutputLatencyFrames();
+	if( std::abs(iLatency - m_iLoggedLatencyFrames) * 1000 > GetSampleRate() )
+	{
+		LOG->Info( "Sound output latency: %.1fms (%i frames)",
+			iLatency * 1000.0f / GetSampleRate(), (int) iLatency );
+		m_iLoggedLatencyFrames = iLatency;
+	}
+
 	m_Mutex.Unlock();
 }
 
 void RageSoundDriver::StartMixing( RageSoundBase *pSound )
 {
-	/* Lock available m_Sounds[], and reserve a slot. */
-	m_SoundListMutex.Lock();
-
+	/* Reserve an available slot.  Once a slot is BUFFERING, no other thread will
+	 * touch it, so prebuffering can take its time without holding anything. */
 	unsigned i;
 	for( i = 0; i < ARRAYLEN(m_Sounds); ++i )
-		if( m_Sounds[i].m_State == Sound::AVAILABLE )
+		if( m_Sounds[i].ChangeState(Sound::AVAILABLE, Sound::BUFFERING) )
 			break;
 	if( i == ARRAYLEN(m_Sounds) )
-	{
-		m_SoundListMutex.Unlock();
 		return;
-	}
 
 	Sound &s = m_Sounds[i];
-	s.m_State = Sound::BUFFERING;
-
-	/* We've reserved our slot; we can safely unlock now.  Don't hold onto it longer
-	 * than needed, since prebuffering might take some time. */
-	m_SoundListMutex.Unlock();
 
 	s.m_pSound = pSound;
 	s.m_StartTime = pSound->GetStartTime();
@@ -354,7 +360,8 @@ void RageSoundDriver::StartMixing( RageSoundBase *pSound )
 			break;
 	}
 
-	s.m_State = Sound::PLAYING;
+	/* Publish the prebuffered data and start time to the decoding and mixing threads. */
+	s.SetState( Sound::PLAYING );
 
 //	LOG->Trace("StartMixing: (#%i) finished prebuffering(%s) (%p)", i, s.m_pSound->GetLoadedFilePath().c_str(), s.m_pSound );
 }
@@ -367,7 +374,7 @@ void RageSoundDriver::StopMixing( RageSoundBase *pSound )
 	/* Find the sound. */
 	unsigned i;
 	for( i = 0; i < ARRAYLEN(m_Sounds); ++i )
-		if( m_Sounds[i].m_State != Sound::AVAILABLE && m_Sounds[i].m_pSound == pSound )
+		if( m_Sounds[i].GetState() != Sound::AVAILABLE && m_Sounds[i].m_pSound == pSound )
 			break;
 	if( i == ARRAYLEN(m_Sounds) )
 	{
@@ -377,7 +384,7 @@ void RageSoundDriver::StopMixing( RageSoundBase *pSound )
 	}
 
 	/* If we're already in STOPPED, there's nothing to do. */
-	if( m_Sounds[i].m_State == Sound::STOPPED )
+	if( m_Sounds[i].GetState() == Sound::STOPPED )
 	{
 		m_Mutex.Unlock();
 		LOG->Trace( "not stopping a sound because it's already in STOPPED" );
@@ -388,7 +395,7 @@ void RageSoundDriver::StopMixing( RageSoundBase *pSound )
 
 	/* Tell the mixing thread to flush the buffer.  We don't have to worry about
 	 * the decoding thread, since we've locked m_Mutex. */
-	m_Sounds[i].m_State = Sound::HALTING;
+	m_Sounds[i].SetState( Sound::HALTING );
 
 	/* Invalidate the m_pSound pointer to guarantee we don't make any further references to
 	 * it.  Once this call returns, the sound may no longer exist. */
@@ -408,20 +415,20 @@ bool RageSoundDriver::PauseMixing( RageSoundBase *pSound, bool bStop )
 	/* Find the sound. */
 	unsigned i;
 	for( i = 0; i < ARRAYLEN(m_Sounds); ++i )
-		if( m_Sounds[i].m_State != Sound::AVAILABLE && m_Sounds[i].m_pSound == pSound )
+		if( m_Sounds[i].GetState() != Sound::AVAILABLE && m_Sounds[i].m_pSound == pSound )
 			break;
 
 	/* A sound can be paused in PLAYING or STOPPING.  (STOPPING means the sound
 	 * has been decoded to the end, and we're waiting for that data to finish, so
 	 * externally it looks and acts like PLAYING.) */
-	if( i == ARRAYLEN(m_Sounds) ||
-		(m_Sounds[i].m_State != Sound::PLAYING && m_Sounds[i].m_State != Sound::STOPPING) )
+	const Sound::State eState = i == ARRAYLEN(m_Sounds)? Sound::AVAILABLE: m_Sounds[i].GetState();
+	if( eState != Sound::PLAYING && eState != Sound::STOPPING )
 	{
 		LOG->Trace( "not pausing a sound because it's not playing" );
 		return false;
 	}
 
-	m_Sounds[i].m_bPaused = bStop;
+	m_Sounds[i].m_bPaused.store( bStop, std::memory_order_relaxed );
 
 	return true;
 }
@@ -446,12 +453,12 @@ void RageSoundDriver::low_sample_count_workaround()
 }
 
 RageSoundDriver::RageSoundDriver():
-	m_Mutex("RageSoundDriver"),
-	m_SoundListMutex("SoundListMutex")
+	m_Mutex("RageSoundDriver")
 {
 	m_bShutdownDecodeThread = false;
 	m_iMaxHardwareFrame = 0;
 	m_iVMaxHardwareFrame = 0;
+	m_iLoggedLatencyFrames = 0;
 	SetDecodeBufferSize( 4096 );
 	soundDriverMaxSamples = PREFSMAN->m_iRageSoundSampleCountClamp;
 	m_DecodeThread.SetName("Decode thread");
@@ -534,10 +541,23 @@ std::int64_t RageSoundDriver::ClampHardwareFrame( std::int64_t iHardwareFrame )
 	return m_iVMaxHardwareFrame;
 }
 
+std::int64_t RageSoundDriver::GetAudiblePosition() const
+{
+	const std::int64_t iPosition = GetPosition();
+	const std::int64_t iLatency = GetOutputLatencyFrames();
+	if( iLatency <= 0 )
+		return iPosition;
+
+	/* Until the first frames have made it through the latency, nothing is
+	 * audible yet.  Don't go negative, or ClampHardwareFrame will think the
+	 * position wrapped. */
+	return std::max( iPosition - iLatency, std::int64_t(0) );
+}
+
 std::int64_t RageSoundDriver::GetHardwareFrame( RageTimer *pTimestamp=nullptr ) const
 {
 	if( pTimestamp == nullptr )
-		return ClampHardwareFrame( GetPosition() );
+		return ClampHardwareFrame( GetAudiblePosition() );
 
 	/*
 	 * We may have unpredictable scheduling delays between updating the timestamp
@@ -553,7 +573,7 @@ std::int64_t RageSoundDriver::GetHardwareFrame( RageTimer *pTimestamp=nullptr )
 	do
 	{
 		pTimestamp->Touch();
-		iPositionFrames = GetPosition();
+		iPositionFrames = GetAudiblePosition();
 	} while( --iTries && pTimestamp->Ago() > 0.002f );
 
 	if( iTries == 0 )
@@ -11,12 +11,21 @@
 
 REGISTER_SOUND_DRIVER_CLASS( JACK );
 
+// In low-latency mode, SoundWriteAhead sets the period size, within these
+// limits, and it's doubled on xruns up to the maximum.
+static const jack_nframes_t low_latency_min_period = 64;
+static const jack_nframes_t low_latency_max_period = 1024;
+
 RageSoundDriver_JACK::RageSoundDriver_JACK() :
 	RageSoundDriver()
 {
 	client = nullptr;
 	port_l = nullptr;
 	port_r = nullptr;
+	latency_frames = 0;
+	xruns = 0;
+	handled_xruns = 0;
+	set_period = false;
 }
 
 RageSoundDriver_JACK::~RageSoundDriver_JACK()
@@ -61,6 +70,25 @@ RString RageSoundDriver_JACK::Init()
 		goto out_close;
 	}
 
+	if (jack_set_latency_callback(client, LatencyTrampoline, this))
+		LOG->Warn("RageSoundDriver_JACK: Couldn't set latency callback; output latency won't be measured");
+
+	// The period belongs to the JACK server and every client on it, so
+	// only change it when the user asked for one with SoundWriteAhead.
+	// Update() will back off if the graph can't keep up.
+	if (PREFSMAN->m_bSoundLowLatency && PREFSMAN->m_iSoundWriteAhead > 0)
+	{
+		const jack_nframes_t period = clamp((jack_nframes_t) PREFSMAN->m_iSoundWriteAhead.Get(), low_latency_min_period, low_latency_max_period);
+
+		if (jack_set_xrun_callback(client, XRunTrampoline, this))
+			LOG->Warn("RageSoundDriver_JACK: Couldn't set xrun callback");
+		if (jack_set_buffer_size(client, period))
+			LOG->Warn("RageSoundDriver_JACK: Couldn't set period to %u frames", (unsigned) period);
+		else
+			set_period = true;
+	}
+	LOG->Info("JACK period: %u frames", (unsigned) jack_get_buffer_size(client));
+
 	// TODO Set a jack_on_shutdown callback as well?  Probably just stop
 	// caring about sound altogether if that happens.
 
@@ -95,6 +123,10 @@ RString RageSoundDriver_JACK::Init()
 		// function.
 		LOG->Warn( "RageSoundDriver_JACK: Couldn't connect ports: %s", error.c_str() );
 
+	// The latency callback may already have run, but our ports weren't
+	// connected yet; measure again now that they are.
+	UpdateLatency();
+
 	// Success!
 	LOG->Trace("JACK sound driver started successfully");
 	return RString();
@@ -191,6 +223,52 @@ std::int64_t RageSoundDriver_JACK::GetPosition() const
 	return jack_frame_time(client);
 }
 
+std::int64_t RageSoundDriver_JACK::GetOutputLatencyFrames() const
+{
+	// ProcessCallback stamps what it mixes with the start of the cycle,
+	// but that data is only played from the next cycle on, and then takes
+	// the port latency to reach the speakers.  Since GetHardwareFrame()
+	// takes this off, sound positions already include it, so GetPlayLatency()
+	// mustn't report it again: callers add that to positions, and
+	// AutoKeysounds would place keysounds late against the music.
+	return jack_get_buffer_size(client) + latency_frames;
+}
+
+void RageSoundDriver_JACK::UpdateLatency()
+{
+	// Playback latency of our output ports: how long after a frame is
+	// written it reaches the physical outputs.  Use the worst case of the
+	// two, since that's the one the player hears last.
+	jack_latency_range_t range_l, range_r;
+	jack_port_get_latency_range(port_l, JackPlaybackLatency, &range_l);
+	jack_port_get_latency_range(port_r, JackPlaybackLatency, &range_r);
+	latency_frames = std::max(range_l.max, range_r.max);
+}
+
+void RageSoundDriver_JACK::Update()
+{
+	RageSoundDriver::Update();
+
+	if (!set_period)
+		return;
+
+	// We had xruns at this period size: it's not stable, so try the next
+	// one up.  (This isn't safe to do from the xrun callback itself.)
+	const int current_xruns = xruns;
+	if (current_xruns == handled_xruns)
+		return;
+	handled_xruns = current_xruns;
+
+	const jack_nframes_t period = jack_get_buffer_size(client);
+	if (period >= low_latency_max_period)
+		return;
+
+	LOG->Info("JACK: xrun at %u-frame period; increasing to %u",
+		(unsigned) period, (unsigned) period*2);
+	if (jack_set_buffer_size(client, period*2))
+		LOG->Warn("RageSoundDriver_JACK: Couldn't set period to %u frames", (unsigned) period*2);
+}
+
 int RageSoundDriver_JACK::GetSampleRate() const
 {
 	// For now, let's pretend there isn't a race condition between this and
@@ -231,6 +309,19 @@ int RageSoundDriver_JACK::SampleRateTrampoline(jack_nframes_t nframes, void *arg
 	return ((RageSoundDriver_JACK *) arg)->SampleRateCallback(nframes);
 }
 
+void RageSoundDriver_JACK::LatencyTrampoline(jack_latency_callback_mode_t mode, void *arg)
+{
+	RageSoundDriver_JACK *driver = (RageSoundDriver_JACK *) arg;
+	if (mode == JackPlaybackLatency && driver->port_l != nullptr && driver->port_r != nullptr)
+		driver->UpdateLatency();
+}
+
+int RageSoundDriver_JACK::XRunTrampoline(void *arg)
+{
+	++((RageSoundDriver_JACK *) arg)->xruns;
+	return 0;
+}
+
 /*
  * (c) 2013 Devin J. Pohly
  * All rights reserved.
@@ -3,6 +3,7 @@
 
 #include "RageSoundDriver.h"
 
+#include <atomic>
 #include <cstdint>
 
 #include <jack/jack.h>
@@ -19,6 +20,8 @@ public:
 
 	int GetSampleRate() const;
 	std::int64_t GetPosition() const;
+	std::int64_t GetOutputLatencyFrames() const;
+	void Update();
 
 private:
 	jack_client_t *client;
@@ -27,6 +30,17 @@ private:
 
 	int sample_rate;
 
+	// Measured playback latency of our ports, in frames.  Written from
+	// the JACK latency callback, read from the main thread.
+	std::atomic<std::int64_t> latency_frames;
+
+	// Low-latency mode: whether we set the period ourselves, xruns seen by
+	// the JACK thread, and how many of them we've already reacted to.
+	bool set_period;
+	std::atomic<int> xruns;
+	int handled_xruns;
+	void UpdateLatency();
+
 	// Helper for Init()
 	RString ConnectPorts();
 
@@ -35,6 +49,8 @@ private:
 	static int ProcessTrampoline(jack_nframes_t nframes, void *arg);
 	int SampleRateCallback(jack_nframes_t nframes);
 	static int SampleRateTrampoline(jack_nframes_t nframes, void *arg);
+	static void LatencyTrampoline(jack_latency_callback_mode_t mode, void *arg);
+	static int XRunTrampoline(void *arg);
 };
 
 #endif